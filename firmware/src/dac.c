@@ -0,0 +1,336 @@
+#include <p18cxxx.h>
+#include "timer.h"
+#include "uart.h"
+#include "dac.h"
+
+/**
+ * Kernel registers
+ * Access bank so the loops are free of MOVLB and can use a = 0
+ */
+#pragma udata access ACCESS_DAC
+near unsigned char DAC_A;      // Position / X
+near unsigned char DAC_B;      // Y
+near unsigned char DAC_N;      // Sample counter
+near unsigned char DAC_K;      // Dwell counter
+near signed char   DAC_Step;   // Run direction
+near unsigned char DAC_Stride; // Y offset for the point list
+near unsigned char DAC_Dwell;  // Dwell per point
+near signed char   DAC_StepB;  // Line: minor axis direction
+near unsigned char DAC_DMaj;   // Line: major axis length
+near unsigned char DAC_DMin;   // Line: minor axis length
+near unsigned char DAC_Err;    // Line: Bresenham error
+near unsigned char DAC_MaskX;  // Sub pixel dwell: X one code up on bit set
+near unsigned char DAC_MaskY;  // Sub pixel dwell: Y one code up on bit set
+
+/**
+ * Dither patterns, n of the 8 samples set for a fraction of n / 8, as far
+ * apart from each other as possible so the spot doesn't flicker
+ */
+rom unsigned char DAC_Dither[8] = {
+    0x00,   // 00000000
+    0x01,   // 00000001
+    0x11,   // 00010001
+    0x29,   // 00101001
+    0x55,   // 01010101
+    0xd6,   // 11010110
+    0xee,   // 11101110
+    0xfe    // 11111110
+};
+
+#pragma code
+
+unsigned char DAC_runY(unsigned char pos, unsigned char n, signed char step){
+    if (n == 0){
+        return pos;
+    }
+    DAC_A    = pos;
+    DAC_N    = n;
+    DAC_Step = step;
+    _asm
+        MOVF    DAC_A, 0, 0
+    runy_loop:
+        MOVWF   LATB, 0             // 1
+        ADDWF   DAC_Step, 0, 0      // 1
+        DECFSZ  DAC_N, 1, 0         // 1 (2 when done)
+        BRA     runy_loop           // 2
+        MOVWF   DAC_A, 0
+    _endasm
+    return DAC_A;
+}
+
+#if defined(UART_Enabled)
+
+/**
+ * USART builds: RC6/RC7 are not ours and the H ladder gets x >> 2 on
+ * RC0-RC5 (see uart.h), plain C versions of the kernels writing LATC.
+ * The cycle figures don't hold here.
+ */
+void DAC_dwell(unsigned char px, unsigned char py, unsigned char n){
+    px >>= 2;
+    while (n > 0){
+        LATB = py;
+        LATC = px;
+        n--;
+    }
+}
+
+void DAC_dwellSub(unsigned char px, unsigned char py, unsigned char nSub){
+    unsigned int  iX;
+    unsigned char n, cx, mx, my;
+
+    // The H ladder only has 6 bits, dither those: the fraction of the 6 bit
+    // code is bits 2-4 of x in 1/8
+    iX = ((unsigned int) px << 3) | (nSub >> 4);
+    cx = (unsigned char) (iX >> 5);
+    mx = (cx == 63) ? 0 : DAC_Dither[(iX >> 2) & 7];
+    my = (py == 255) ? 0 : DAC_Dither[nSub & 7];
+    for (n = DAC_SubSamples; n > 0; n--){
+        LATB = py + (my & 1);
+        LATC = cx + (mx & 1);
+        mx >>= 1;
+        my >>= 1;
+    }
+}
+
+unsigned char DAC_runX(unsigned char pos, unsigned char n, signed char step){
+    while (n > 0){
+        LATC = pos >> 2;
+        pos += step;
+        n--;
+    }
+    return pos;
+}
+
+void DAC_points(unsigned char *pList, unsigned char n, unsigned char nStride, unsigned char nDwell){
+    unsigned char k;
+
+    while (n > 0){
+        LATB = pList[nStride];
+        LATC = *pList >> 2;
+        for (k = nDwell; k > 0; k--){
+        }
+        pList++;
+        n--;
+    }
+}
+
+void DAC_line(unsigned char x0, unsigned char y0, unsigned char x1, unsigned char y1){
+    unsigned char dx, dy, n, err;
+    signed char   sx = 1;
+    signed char   sy = 1;
+
+    if (x1 >= x0){
+        dx = x1 - x0;
+    }
+    else{
+        dx = x0 - x1;
+        sx = -1;
+    }
+    if (y1 >= y0){
+        dy = y1 - y0;
+    }
+    else{
+        dy = y0 - y1;
+        sy = -1;
+    }
+
+    if (dx >= dy){
+        err = dx >> 1;
+        for (n = dx; n > 0; n--){
+            LATB = y0;
+            LATC = x0 >> 2;
+            x0 += sx;
+            if (err < dy){
+                err += dx - dy;
+                y0  += sy;
+            }
+            else{
+                err -= dy;
+            }
+        }
+    }
+    else{
+        err = dy >> 1;
+        for (n = dy; n > 0; n--){
+            LATB = y0;
+            LATC = x0 >> 2;
+            y0 += sy;
+            if (err < dx){
+                err += dy - dx;
+                x0  += sx;
+            }
+            else{
+                err -= dx;
+            }
+        }
+    }
+}
+
+#else
+
+void DAC_dwell(unsigned char px, unsigned char py, unsigned char n){
+    if (n == 0){
+        return;
+    }
+    DAC_A = px;
+    DAC_B = py;
+    DAC_N = n;
+    _asm
+        MOVF    DAC_B, 0, 0
+    dwell_loop:
+        MOVWF   LATB, 0             // 1
+        MOVFF   DAC_A, LATC         // 2
+        DECFSZ  DAC_N, 1, 0         // 1 (2 when done)
+        BRA     dwell_loop          // 2
+    _endasm
+}
+
+void DAC_dwellSub(unsigned char px, unsigned char py, unsigned char nSub){
+    DAC_A     = px;
+    DAC_B     = py;
+    DAC_N     = DAC_SubSamples;
+    // Code 255 can't go one up
+    DAC_MaskX = (px == 255) ? 0 : DAC_Dither[nSub >> 4];
+    DAC_MaskY = (py == 255) ? 0 : DAC_Dither[nSub & 7];
+    _asm
+    dwellsub_loop:
+        RRCF    DAC_MaskY, 1, 0     // 1  C = next Y bit
+        MOVLW   0                   // 1
+        ADDWFC  DAC_B, 0, 0         // 1  W = y + C
+        MOVWF   LATB, 0             // 1
+        RRCF    DAC_MaskX, 1, 0     // 1  C = next X bit
+        MOVLW   0                   // 1
+        ADDWFC  DAC_A, 0, 0         // 1  W = x + C
+        MOVWF   LATC, 0             // 1
+        DECFSZ  DAC_N, 1, 0         // 1 (2 when done)
+        BRA     dwellsub_loop       // 2
+    _endasm
+}
+
+unsigned char DAC_runX(unsigned char pos, unsigned char n, signed char step){
+    if (n == 0){
+        return pos;
+    }
+    DAC_A    = pos;
+    DAC_N    = n;
+    DAC_Step = step;
+    _asm
+        MOVF    DAC_A, 0, 0
+    runx_loop:
+        MOVWF   LATC, 0             // 1
+        ADDWF   DAC_Step, 0, 0      // 1
+        DECFSZ  DAC_N, 1, 0         // 1 (2 when done)
+        BRA     runx_loop           // 2
+        MOVWF   DAC_A, 0
+    _endasm
+    return DAC_A;
+}
+
+void DAC_points(unsigned char *pList, unsigned char n, unsigned char nStride, unsigned char nDwell){
+    if (n == 0 || nDwell == 0){
+        return;
+    }
+    DAC_N      = n;
+    DAC_Stride = nStride;
+    DAC_Dwell  = nDwell;
+    // FSR0 is free for us, C18 keeps the stack in FSR1 and the frame in FSR2
+    FSR0L = (unsigned char) ((unsigned int) pList);
+    FSR0H = (unsigned char) ((unsigned int) pList >> 8);
+    _asm
+        MOVF    DAC_Stride, 0, 0
+    points_loop:
+        MOVFF   PLUSW0, LATB        // 2  y = pList[i + nStride]
+        MOVFF   POSTINC0, LATC      // 2  x = pList[i], i++
+        MOVFF   DAC_Dwell, DAC_K    // 2
+    points_dwell:
+        DECFSZ  DAC_K, 1, 0         // 1 (2 when done)
+        BRA     points_dwell        // 2
+        DECFSZ  DAC_N, 1, 0         // 1 (2 when done)
+        BRA     points_loop         // 2
+    _endasm
+}
+
+void DAC_line(unsigned char x0, unsigned char y0, unsigned char x1, unsigned char y1){
+    unsigned char dx, dy;
+    signed char   sx = 1;
+    signed char   sy = 1;
+
+    if (x1 >= x0){
+        dx = x1 - x0;
+    }
+    else{
+        dx = x0 - x1;
+        sx = -1;
+    }
+    if (y1 >= y0){
+        dy = y1 - y0;
+    }
+    else{
+        dy = y0 - y1;
+        sy = -1;
+    }
+
+    // A walks the major axis one step per sample, B follows when the error
+    // runs out. Only the DAC whose value changed is written.
+    if (dx >= dy){
+        if (dx == 0){
+            return;
+        }
+        DAC_A     = x0;
+        DAC_B     = y0;
+        DAC_Step  = sx;
+        DAC_StepB = sy;
+        DAC_DMaj  = dx;
+        DAC_DMin  = dy;
+        DAC_N     = dx;
+        DAC_Err   = dx >> 1;
+        _asm
+            MOVFF   DAC_B, LATB
+        linex_loop:
+            MOVFF   DAC_A, LATC         // 2
+            MOVF    DAC_Step, 0, 0      // 1
+            ADDWF   DAC_A, 1, 0         // 1  x += sx
+            MOVF    DAC_DMin, 0, 0      // 1
+            SUBWF   DAC_Err, 1, 0       // 1  err -= dy
+            BC      linex_next          // 2 (1 on a minor step)
+            MOVF    DAC_DMaj, 0, 0      // 1
+            ADDWF   DAC_Err, 1, 0       // 1  err += dx
+            MOVF    DAC_StepB, 0, 0     // 1
+            ADDWF   DAC_B, 1, 0         // 1  y += sy
+            MOVFF   DAC_B, LATB         // 2
+        linex_next:
+            DECFSZ  DAC_N, 1, 0         // 1 (2 when done)
+            BRA     linex_loop          // 2
+        _endasm
+    }
+    else{
+        DAC_A     = y0;
+        DAC_B     = x0;
+        DAC_Step  = sy;
+        DAC_StepB = sx;
+        DAC_DMaj  = dy;
+        DAC_DMin  = dx;
+        DAC_N     = dy;
+        DAC_Err   = dy >> 1;
+        _asm
+            MOVFF   DAC_B, LATC
+        liney_loop:
+            MOVFF   DAC_A, LATB         // 2
+            MOVF    DAC_Step, 0, 0      // 1
+            ADDWF   DAC_A, 1, 0         // 1  y += sy
+            MOVF    DAC_DMin, 0, 0      // 1
+            SUBWF   DAC_Err, 1, 0       // 1  err -= dx
+            BC      liney_next          // 2 (1 on a minor step)
+            MOVF    DAC_DMaj, 0, 0      // 1
+            ADDWF   DAC_Err, 1, 0       // 1  err += dy
+            MOVF    DAC_StepB, 0, 0     // 1
+            ADDWF   DAC_B, 1, 0         // 1  x += sx
+            MOVFF   DAC_B, LATC         // 2
+        liney_next:
+            DECFSZ  DAC_N, 1, 0         // 1 (2 when done)
+            BRA     liney_loop          // 2
+        _endasm
+    }
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * File:   dac.h
+ *
+ * DAC streaming kernels
+ * Hand written _asm loops that feed the R2R DACs (V on PORTB, H on PORTC).
+ * The C wrappers copy their arguments to access bank registers and run the
+ * loop, so the beam speed only depends on the instruction clock:
+ *
+ *   Kernel       Cycles per sample          Writes
+ *   DAC_dwell    6 (last sample 5)          LATB + LATC
+ *   DAC_dwellSub 11 (last sample 10)        LATB + LATC
+ *   DAC_runX     5 (last sample 4)          LATC
+ *   DAC_runY     5 (last sample 4)          LATB
+ *   DAC_points   3 * nDwell + 8 per point   LATB + LATC
+ *                (last point one less)
+ *   DAC_line     11, 16 when the minor      LATC (X major) or LATB (Y major),
+ *                axis steps too             the other one on minor steps
+ *
+ * One cycle is 4 / Fosc. Wrapper entry/exit is not included in the figures.
+ * A count of 0 does nothing.
+ */
+
+#ifndef DAC_H
+#define	DAC_H
+
+/**
+ * Hold the beam at (px, py) for n samples
+ */
+void DAC_dwell(unsigned char px, unsigned char py, unsigned char n);
+
+/**
+ * Sub pixel dwell: DAC_SubSamples samples around (px, py). nSub is the
+ * fraction of a code, in 1/8, of X (high nibble) and Y (low nibble): that
+ * many samples out of 8 go one code up, spread by DAC_Dither, so the beam
+ * averages out between two codes
+ */
+#define DAC_SubSamples  8
+void DAC_dwellSub(unsigned char px, unsigned char py, unsigned char nSub);
+
+/**
+ * Horizontal run: writes pos, pos + step, ... (n samples) to the H DAC
+ * Returns the next position, pos + n * step, which is not written
+ */
+unsigned char DAC_runX(unsigned char pos, unsigned char n, signed char step);
+
+/**
+ * Vertical run: same as DAC_runX on the V DAC
+ */
+unsigned char DAC_runY(unsigned char pos, unsigned char n, signed char step);
+
+/**
+ * Point list: for i in 0..n-1 beam goes to (pList[i], pList[i + nStride])
+ * and stays there for nDwell delay loops (nDwell >= 1)
+ * nStride must be < 128 (Y values are read with PLUSW0)
+ */
+void DAC_points(unsigned char *pList, unsigned char n, unsigned char nStride, unsigned char nDwell);
+
+/**
+ * Line: Bresenham from (x0, y0) towards (x1, y1), one sample per step along
+ * the major axis. (x1, y1) is not written, so segments can be chained end to
+ * start without drawing the joints twice
+ */
+void DAC_line(unsigned char x0, unsigned char y0, unsigned char x1, unsigned char y1);
+
+#endif	/* DAC_H */
+
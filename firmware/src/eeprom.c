@@ -0,0 +1,42 @@
+#include <p18cxxx.h>
+#include "eeprom.h"
+
+#pragma code
+
+unsigned char EE_read(unsigned char nAddr){
+    EEADR = nAddr;
+    EECON1bits.EEPGD = 0;   // Data EEPROM, not flash
+    EECON1bits.CFGS  = 0;
+    EECON1bits.RD    = 1;   // Data is there on the next cycle
+    return EEDATA;
+}
+
+void EE_readBlock(unsigned char nAddr, unsigned char *pDst, unsigned char n){
+    while (n > 0){
+        *pDst++ = EE_read(nAddr++);
+        n--;
+    }
+}
+
+void EE_write(unsigned char nAddr, unsigned char nData){
+    unsigned char nGie;
+
+    if (EE_read(nAddr) == nData){
+        return;
+    }
+    EEADR  = nAddr;
+    EEDATA = nData;
+    EECON1bits.EEPGD = 0;
+    EECON1bits.CFGS  = 0;
+    EECON1bits.WREN  = 1;
+    // The unlock sequence must run without an interrupt in between
+    nGie = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    EECON2 = 0x55;
+    EECON2 = 0xAA;
+    EECON1bits.WR = 1;
+    INTCONbits.GIE = nGie;
+    while (EECON1bits.WR){      // Cleared by the hardware when done
+    }
+    EECON1bits.WREN = 0;
+}
@@ -0,0 +1,37 @@
+/*
+ * File:   eeprom.h
+ *
+ * Data EEPROM
+ * 256 bytes that survive a reflash when the programmer is told to keep
+ * them, for the per cabinet settings. Blank cells read 0xFF.
+ *
+ * Map:
+ *   0x00-0x0F   Court geometry and view (COURT_* in main.c)
+ *   0x10-0x1F   Render, timing and physics tune (TUNE_* in main.c)
+ *
+ * A write takes about 4 ms and a cell lasts some 100k of them: write when
+ * something is saved, never from the frame loop.
+ */
+
+#ifndef EEPROM_H
+#define	EEPROM_H
+
+#define EE_Court      0x00
+#define EE_Tune       0x10
+
+/**
+ * Read one byte
+ */
+unsigned char EE_read(unsigned char nAddr);
+
+/**
+ * Read n bytes from nAddr on into pDst
+ */
+void EE_readBlock(unsigned char nAddr, unsigned char *pDst, unsigned char n);
+
+/**
+ * Write one byte and wait for it, a cell that already holds it is left alone
+ */
+void EE_write(unsigned char nAddr, unsigned char nData);
+
+#endif	/* EEPROM_H */
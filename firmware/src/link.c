@@ -0,0 +1,384 @@
+#include "typedefs.h"
+#include "uart.h"
+#include "link.h"
+
+#if defined(LINK)
+
+#define LINK_Sync     0x5A
+#define LINK_Hello    0x01
+#define LINK_Input    0x02
+#define LINK_PacketMax (12 + LINK_Window)
+
+#pragma udata
+
+byte LINK_Side       = 0;
+word LINK_Config     = 0;
+word LINK_Seed       = 0;
+byte LINK_In[2];
+
+word LINK_Frame      = 0;
+byte LINK_LatLast    = 0;
+byte LINK_LatMax     = 0;
+byte LINK_Rtt        = 0;
+word LINK_Resends    = 0;
+word LINK_BadPackets = 0;
+word LINK_Desyncs    = 0;
+word LINK_Refused    = 0;
+
+byte LINK_State      = LINK_Wait;
+byte LINK_Event      = 0;     // Paired since the last LINK_poll()
+word LINK_Nonce      = 0;
+word LINK_PeerNonce  = 0;
+word LINK_Ms         = 0;     // Clock, ms
+word LINK_LastRx     = 0;
+word LINK_LastTx     = 0;
+
+// Steps are counted from pairing, ring slots are step & LINK_Mask
+word LINK_LocalTop   = 0;     // Next local step to sample
+word LINK_RemoteTop  = 0;     // Next step the peer has to send
+word LINK_PeerAck    = 0;     // Next local step the peer needs
+byte LINK_Local[LINK_Window];
+byte LINK_Remote[LINK_Window];
+word LINK_Stamp[LINK_Window]; // LINK_Ms when the local input was sampled
+byte LINK_Sum[LINK_Window];   // Game checksum after each step
+word LINK_PeerSumFrame = 0;   // Peer checksum for a step not run here yet
+byte LINK_PeerSum      = 0;
+byte LINK_PeerSumSet   = 0;
+
+// Packets
+byte LINK_Tx[LINK_PacketMax];
+byte LINK_Rx[LINK_PacketMax];
+byte LINK_RxLen      = 0;
+byte LINK_RxNeed     = 0;
+
+word LINK_check(byte *p, byte n);
+void LINK_send(byte n);
+void LINK_sendHello(byte nPaired);
+void LINK_sendInput(void);
+void LINK_reset(void);
+void LINK_restart(void);
+void LINK_rxByte(byte b);
+void LINK_rxHello(void);
+void LINK_rxInput(void);
+
+#pragma code
+
+void LINK_init(word nNonce){
+    UART_init();
+    LINK_Nonce  = nNonce;
+    LINK_State  = LINK_Wait;
+    LINK_Event  = 0;
+    LINK_Ms     = 0;
+    LINK_LastTx = 0 - LINK_HelloMs;
+    LINK_RxLen  = 0;
+}
+
+byte LINK_poll(byte nMs){
+    LINK_Ms += nMs;
+
+    while (UART_rxCount()){
+        LINK_rxByte(UART_rxGet());
+    }
+
+    if (LINK_State == LINK_Wait){
+        if ((word) (LINK_Ms - LINK_LastTx) >= LINK_HelloMs){
+            LINK_sendHello(0);
+        }
+    }
+    else if ((word) (LINK_Ms - LINK_LastRx) >= LINK_Timeout){
+        // Peer gone, pair again
+        LINK_restart();
+    }
+    else if ((word) (LINK_Ms - LINK_LastTx) >= LINK_Resend){
+        // Stalled, the last packet may have been lost
+        LINK_Resends++;
+        LINK_sendInput();
+    }
+
+    if (LINK_Event){
+        LINK_Event = 0;
+        if (LINK_State == LINK_Run){
+            return LINK_Start;
+        }
+    }
+    return LINK_State;
+}
+
+byte LINK_ready(void){
+    return LINK_State == LINK_Run
+        && LINK_RemoteTop != LINK_Frame
+        && (word) (LINK_LocalTop - LINK_PeerAck) < LINK_Window;
+}
+
+void LINK_begin(byte nLocal){
+    byte i;
+    word lat;
+
+    i = (byte) LINK_LocalTop & LINK_Mask;
+    LINK_Local[i] = nLocal;
+    LINK_Stamp[i] = LINK_Ms;
+    LINK_LocalTop++;
+    LINK_sendInput();
+
+    i = (byte) LINK_Frame & LINK_Mask;
+    LINK_In[LINK_Side]     = LINK_Local[i];
+    LINK_In[LINK_Side ^ 1] = LINK_Remote[i];
+
+    // The first LINK_Delay steps run on neutral inputs nobody sampled
+    if (LINK_Frame >= LINK_Delay){
+        lat = LINK_Ms - LINK_Stamp[i];
+        LINK_LatLast = (lat > 255) ? 255 : (byte) lat;
+        if (LINK_LatLast > LINK_LatMax){
+            LINK_LatMax = LINK_LatLast;
+        }
+    }
+}
+
+void LINK_end(byte nSum){
+    LINK_Sum[(byte) LINK_Frame & LINK_Mask] = nSum;
+    if (LINK_PeerSumSet && LINK_PeerSumFrame == LINK_Frame){
+        LINK_PeerSumSet = 0;
+        if (LINK_PeerSum != nSum){
+            LINK_Desyncs++;
+            LINK_restart();
+            return;
+        }
+    }
+    LINK_Frame++;
+}
+
+/**
+ * Fletcher style check: sum of the bytes and sum of the running sums. A byte
+ * lost on the line shifts everything after it, a plain sum lets 1 in 256 of
+ * those through and the inputs in them would desync the boards.
+ */
+word LINK_check(byte *p, byte n){
+    byte a = 0;
+    byte b = 0;
+
+    while (n > 0){
+        a += *p++;
+        b += a;
+        n--;
+    }
+    return a | ((word) b << 8);
+}
+
+/**
+ * Check LINK_Tx[0..n-3] into the last two bytes and queue it, the packet is
+ * dropped when the TX ring can't take it whole
+ */
+void LINK_send(byte n){
+    byte i;
+    word nCheck;
+
+    nCheck = LINK_check(LINK_Tx, n - 2);
+    LINK_Tx[n - 2] = (byte) nCheck;
+    LINK_Tx[n - 1] = (byte) (nCheck >> 8);
+
+    LINK_LastTx = LINK_Ms;
+    if (UART_txFree() < n){
+        return;
+    }
+    for (i = 0; i < n; i++){
+        UART_txPut(LINK_Tx[i]);
+    }
+}
+
+void LINK_sendHello(byte nPaired){
+    LINK_Tx[0] = LINK_Sync;
+    LINK_Tx[1] = LINK_Hello;
+    LINK_Tx[2] = (byte) LINK_Nonce;
+    LINK_Tx[3] = (byte) (LINK_Nonce >> 8);
+    LINK_Tx[4] = nPaired;
+    LINK_Tx[5] = (byte) LINK_Config;
+    LINK_Tx[6] = (byte) (LINK_Config >> 8);
+    LINK_send(9);
+}
+
+void LINK_sendInput(void){
+    byte i, n;
+    word f;
+
+    // Everything the peer has not acknowledged
+    f = LINK_PeerAck;
+    n = (byte) (LINK_LocalTop - f);
+
+    LINK_Tx[0] = LINK_Sync;
+    LINK_Tx[1] = LINK_Input;
+    LINK_Tx[2] = (byte) f;
+    LINK_Tx[3] = (byte) (f >> 8);
+    LINK_Tx[4] = n;
+    for (i = 0; i < n; i++){
+        LINK_Tx[5 + i] = LINK_Local[(byte) (f + i) & LINK_Mask];
+    }
+    LINK_Tx[5 + n] = (byte) LINK_RemoteTop;
+    LINK_Tx[6 + n] = (byte) (LINK_RemoteTop >> 8);
+    // Steps done and the checksum after the last one
+    LINK_Tx[7 + n] = (byte) LINK_Frame;
+    LINK_Tx[8 + n] = (byte) (LINK_Frame >> 8);
+    LINK_Tx[9 + n] = LINK_Sum[(byte) (LINK_Frame - 1) & LINK_Mask];
+    LINK_send(12 + n);
+}
+
+/**
+ * Back to step 0, the first LINK_Delay steps are neutral on both boards
+ */
+void LINK_reset(void){
+    byte i;
+
+    LINK_Frame     = 0;
+    LINK_LocalTop  = LINK_Delay;
+    LINK_RemoteTop = LINK_Delay;
+    LINK_PeerAck   = LINK_Delay;
+    for (i = 0; i < LINK_Window; i++){
+        LINK_Local[i]  = 0;
+        LINK_Remote[i] = 0;
+        LINK_Stamp[i]  = LINK_Ms;
+        LINK_Sum[i]    = 0;
+    }
+    LINK_PeerSumSet = 0;
+    LINK_LastRx     = LINK_Ms;
+    LINK_LatMax     = 0;
+}
+
+/**
+ * Drop the session and pair again, the HELLO makes the peer do the same
+ */
+void LINK_restart(void){
+    LINK_State = LINK_Wait;
+    LINK_sendHello(0);
+}
+
+void LINK_rxByte(byte b){
+    word nCheck;
+
+    if (LINK_RxLen == 0 && b != LINK_Sync){
+        return;
+    }
+    LINK_Rx[LINK_RxLen++] = b;
+
+    if (LINK_RxLen == 2){
+        if (b == LINK_Hello){
+            LINK_RxNeed = 9;
+        }
+        else if (b != LINK_Input){
+            LINK_BadPackets++;
+            LINK_RxLen = 0;
+        }
+        return;
+    }
+    if (LINK_RxLen == 5 && LINK_Rx[1] == LINK_Input){
+        if (b > LINK_Window){
+            LINK_BadPackets++;
+            LINK_RxLen = 0;
+            return;
+        }
+        LINK_RxNeed = 12 + b;
+    }
+    if (LINK_RxLen < 5 || LINK_RxLen < LINK_RxNeed){
+        return;
+    }
+
+    nCheck = LINK_check(LINK_Rx, LINK_RxLen - 2);
+    LINK_RxLen = 0;
+    if ((byte) nCheck != LINK_Rx[LINK_RxNeed - 2] || (byte) (nCheck >> 8) != LINK_Rx[LINK_RxNeed - 1]){
+        LINK_BadPackets++;
+        return;
+    }
+
+    if (LINK_Rx[1] == LINK_Hello){
+        LINK_rxHello();
+    }
+    else{
+        LINK_rxInput();
+    }
+}
+
+void LINK_rxHello(void){
+    word nPeer = LINK_Rx[2] | ((word) LINK_Rx[3] << 8);
+
+    if ((LINK_Rx[5] | ((word) LINK_Rx[6] << 8)) != LINK_Config){
+        // Another court or physics: wait for the peer to match, running
+        // would only desync
+        LINK_Refused++;
+        LINK_State = LINK_Wait;
+        return;
+    }
+    if (LINK_State == LINK_Run){
+        if (LINK_Rx[4]){
+            // Peer answering our HELLO, or a late copy
+            return;
+        }
+        if (nPeer == LINK_PeerNonce && LINK_RemoteTop == LINK_Delay){
+            // Peer still pairing, it missed our answer
+            LINK_sendHello(1);
+            return;
+        }
+        // Peer restarted
+        LINK_State = LINK_Wait;
+    }
+
+    if (nPeer == LINK_Nonce){
+        // Same nonce on both, pick another one, the clocks won't match
+        LINK_Nonce = LINK_Nonce * 109 + 89 + (byte) LINK_Ms;
+        return;
+    }
+    LINK_PeerNonce = nPeer;
+    LINK_Side      = (LINK_Nonce > nPeer) ? 1 : 0;
+    LINK_Seed      = LINK_Side ? nPeer : LINK_Nonce;
+    LINK_reset();
+    LINK_State     = LINK_Run;
+    LINK_Event     = 1;
+    LINK_sendHello(1);
+}
+
+void LINK_rxInput(void){
+    byte i, n;
+    word f, ack, done;
+
+    if (LINK_State != LINK_Run){
+        return;
+    }
+    LINK_LastRx = LINK_Ms;
+
+    // Inputs, only the next one in order is taken
+    f = LINK_Rx[2] | ((word) LINK_Rx[3] << 8);
+    n = LINK_Rx[4];
+    for (i = 0; i < n; i++, f++){
+        if (f == LINK_RemoteTop && (word) (f - LINK_Frame) < LINK_Window){
+            LINK_Remote[(byte) f & LINK_Mask] = LINK_Rx[5 + i];
+            LINK_RemoteTop++;
+        }
+    }
+
+    // Ack, round trip of the newest input acknowledged
+    ack = LINK_Rx[5 + n] | ((word) LINK_Rx[6 + n] << 8);
+    if (ack != LINK_PeerAck && (word) (ack - LINK_PeerAck) <= (word) (LINK_LocalTop - LINK_PeerAck)){
+        f = LINK_Ms - LINK_Stamp[(byte) (ack - 1) & LINK_Mask];
+        LINK_Rtt = (f > 255) ? 255 : (byte) f;
+        LINK_PeerAck = ack;
+    }
+
+    // Desync check against our checksum of the same step
+    done = LINK_Rx[7 + n] | ((word) LINK_Rx[8 + n] << 8);
+    if (done == 0){
+        return;
+    }
+    f = done - 1;
+    if ((word) (LINK_Frame - done) < LINK_Window){
+        // Already run here
+        if (LINK_Sum[(byte) f & LINK_Mask] != LINK_Rx[9 + n]){
+            LINK_Desyncs++;
+            LINK_restart();
+        }
+    }
+    else if ((word) (f - LINK_Frame) < LINK_Window){
+        // Peer is ahead, check it in LINK_end()
+        LINK_PeerSumFrame = f;
+        LINK_PeerSum      = LINK_Rx[9 + n];
+        LINK_PeerSumSet   = 1;
+    }
+}
+
+#endif
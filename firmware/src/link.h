@@ -0,0 +1,114 @@
+/*
+ * File:   link.h
+ *
+ * Two board lockstep link
+ * Two cabinets wired TX to RX run the same game and only exchange the
+ * player inputs, one byte per game step. Step n is run on both boards with
+ * the same inputs, so they stay in step without ever sending game state.
+ *
+ *  - Pairing: both send HELLO with a random nonce, the lower one is the left
+ *    player and its nonce seeds GAME_rand() on both boards. Then both
+ *    restart the game from step 0. The HELLO also carries LINK_Config, a
+ *    checksum of the settings the game depends on (the court but the view,
+ *    the gravity and hit strength of the tune): a board refuses to pair
+ *    with a peer whose checksum differs, the two games would part at once.
+ *    Both keep sending HELLOs until the settings match.
+ *  - Input delay: the local input sampled at step n is used at step
+ *    n + LINK_Delay, which gives it time to cross the line. Steps 0 to
+ *    LINK_Delay - 1 use neutral inputs on both boards.
+ *  - Resend window: every INPUT packet carries all the local inputs the peer
+ *    has not acknowledged yet (at most LINK_Window), so a lost packet is
+ *    covered by the next one. When the game is stalled waiting for the peer
+ *    the last packet goes out again every LINK_Resend ms.
+ *  - Desync: every packet carries a checksum of the game state after the
+ *    last step, a mismatch (or nothing heard for LINK_Timeout ms) goes back
+ *    to pairing and restarts the game.
+ *
+ * Packets, little endian:
+ *   HELLO  5A 01 nonce(2) paired(1) config(2) check(2)
+ *   INPUT  5A 02 first(2) count(1) inputs(count) ack(2) done(2) sum(1) check(2)
+ *          ack:  next step the sender needs from the peer
+ *          done: steps run by the sender, sum is the game checksum after the
+ *                last one
+ *          check: sum of the bytes before, then sum of the running sums
+ *
+ * Input byte: bit 7 button pressed, bits 0-6 angle
+ *
+ * Only built with LINK defined. The USART is shared, TELEMETRY can't be on.
+ * tools/linksim.c builds this file on Linux to run two boards over a
+ * socketpair with injected latency and loss.
+ */
+
+#ifndef LINK_H
+#define	LINK_H
+
+#define LINK_Delay    3       // Input delay, steps
+#define LINK_Window   8       // Inputs kept per side, power of 2
+#define LINK_Mask     (LINK_Window - 1)
+#define LINK_Resend   60      // ms without sending while stalled
+#define LINK_HelloMs  100     // ms between HELLOs while pairing
+#define LINK_Timeout  2000    // ms without hearing from the peer
+
+#if LINK_Delay * 2 + 1 > LINK_Window
+#error "LINK_Window can't hold the inputs in flight"
+#endif
+
+// Input byte
+#define LINK_Btn      0x80
+#define LINK_Angle    0x7f
+
+// LINK_poll() results
+#define LINK_Wait     0       // Pairing
+#define LINK_Start    1       // Just paired: GAME_seed(LINK_Seed) and restart the game
+#define LINK_Run      2
+
+#if defined(LINK)
+
+extern byte LINK_Side;        // Local player, 0: left, 1: right
+extern word LINK_Config;      // Game settings checksum, set by the game
+extern word LINK_Seed;
+extern byte LINK_In[2];       // Inputs of the step being run, left and right
+
+// Stats
+extern word LINK_Frame;       // Steps run since pairing
+extern byte LINK_LatLast;     // ms from sampling a local input to running its step
+extern byte LINK_LatMax;
+extern byte LINK_Rtt;         // ms from sending an input to its ack
+extern word LINK_Resends;
+extern word LINK_BadPackets;
+extern word LINK_Desyncs;
+extern word LINK_Refused;     // HELLOs with other settings
+
+/**
+ * Start pairing, nNonce should differ between the two boards
+ */
+void LINK_init(word nNonce);
+
+/**
+ * Receive, resend, time out. Call once per frame with the ms elapsed
+ */
+byte LINK_poll(byte nMs);
+
+/**
+ * 1 when the inputs of both players for the next step are in
+ */
+byte LINK_ready(void);
+
+/**
+ * Before the step: queue the local input for step LINK_Frame + LINK_Delay,
+ * send it and load LINK_In with the inputs of this step
+ */
+void LINK_begin(byte nLocal);
+
+/**
+ * After the step: game state checksum, for the desync check
+ */
+void LINK_end(byte nSum);
+
+#else
+
+#define LINK_init(n)
+
+#endif
+
+#endif	/* LINK_H */
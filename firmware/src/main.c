@@ -9,9 +9,14 @@
  * 
  */
 
+#if defined(CLOCK_HSPLL)
+#pragma config OSC = HSPLL      // Oscillator Selection bits (HS oscillator with PLL enabled, 4 x Fosc)
+#else
 #pragma config OSC = RCIO       // Oscillator Selection bits (RC oscillator w/ OSC2 configured as RA6)
+#endif
 #pragma config LVP = OFF        // Low-Voltage ICSP Enable bit (Low-Voltage ICSP disabled)
-#pragma config WDT = OFF        // Watchdog Timer Enable bit (WDT enabled)
+#pragma config WDT = OFF        // Watchdog Timer Enable bit (WDT disabled, SWDTEN turns it on for the idle sleep)
+#pragma config WDTPS = 4        // Watchdog Postscale (1:4, ~72 ms), only used to wake from idle
 
 
 
@@ -19,46 +24,121 @@
 #include <p18f258.h>
 #include "typedefs.h" 
 #include "sintable.h" 
-#include <math.h>		//gives rand() function
-#include <stdlib.h>		//gives rand() function
+#include "dac.h" 
+#include "timer.h" 
+#include "prof.h" 
+#include "uart.h" 
+#include "telem.h" 
+#include "link.h" 
+#include "eeprom.h" 
+#include "rally.h" 
+#include "task.h" 
+#include <math.h>		//gives floor() function
 
 /* GAME CONSTANTS */
 
-// Gravity
-#define g 0.8
-
-#define force 1.4
+// Gravity and hit strength, hundredths (0.80 and 1.40)
+#define Ball_Gravity 80
+#define Ball_Force   140
 
 // TimeStep
 #define ts 0.020
 
+// Court and tune defaults, the game uses the runtime COURT and TUNE (EEPROM)
+// below
 // Net X position and height
 #define Net_X        127
 #define Net_H        61
 #define Net_Repeat   2
 
-// Trail length
+// Trail length, steps (also the most TUNE allows)
 #define Ball_Trail   20
 #define Ball_MaxHits 10
-#define Ball_Repeat  5
-#define Ball_Wait    1000
-#define Ball_WaitShort 100
+#define Ball_Repeat  8            // DAC_dwell samples (6 cycles each)
+#define Trail_Dwell  30           // DAC_points delay loops per trail point (3 cycles each)
+// TRAIL_VECTOR builds: the trail is a polyline of the points where the path bends
+#define Trail_Vertices 8          // Vertices kept per ball, the last one is the ball
+#define Trail_Span   5            // Steps between two vertices at most
+#define Trail_Dev    1            // Distance off the segment (px) that makes a new vertex
+#define Ball_Wait    20000        // ms
+#define Ball_WaitShort 2000       // ms
 #define Ball_H       110
 #define Ball_L       25
 #define Ball_R       230
 
+// Ball store capacity, balls above 0 only exist in stress mode
+#define BALL_Max     4
+// Stress mode: seconds spent at each ball count
+#define STRESS_Period 5
+
 #define Angle_Delta  48
 #define Angle_Max    127
 #define Angle_Min    16
 
-#define TIMER_Mode_Auto    65000
-#define TIMER_Mode_Players 5000
-
-#define L_AUTO_X     Net_X - 20
-#define R_AUTO_X     Net_X + 20
+// Idle timers, seconds (TUNE keeps them in 10 s)
+#define TIMER_Mode_Auto    1300
+#define TIMER_Mode_Players 100
+// MODE_DESC.Idle: which one
+#define TIMER_Auto         0
+#define TIMER_Players      1
+
+// Game modes, index in MODE_Table (mode pins value)
+#define MODE_Auto      0
+#define MODE_2P        1          // 2P Original (No rules)
+#define MODE_2PRules   2
+#define MODE_1P        3          // 1P with Rules, right player is the AI
+#define MODE_Count     4
+#define MODE_Sleep     255        // OnIdle: scope off until someone shows up
+
+// Mode flags
+#define MODE_AutoL     0x01
+#define MODE_AutoR     0x02
+#define MODE_SingleHit 0x04
+#define MODE_DeadBall  0x08
+
+// Debug overlay pages, PROFILE builds show one per ball in four
+#define DEBUG_PageGame    0
+#define DEBUG_PageStages  1       // PROFILE: Timer1 ticks per main loop stage
+#define DEBUG_PageTasks   2       // PROFILE: Timer1 ticks per task
+#define DEBUG_PageLatency 3       // PROFILE: input to photon latency
+#define DEBUG_PageTune    4       // Tuning menu
+#define DEBUG_Top         235     // First row
+#define DEBUG_RowH        25
+
+// Game step period, ms. Steps are run at this rate whatever the frame rate is
+#define PHYS_Period  20
+#define PHYS_MaxLag  (4 * PHYS_Period)
+
+// Swept collision results
+#define PHYS_NoHit   0xffff
+#define PHYS_None    0
+#define PHYS_WallL   1
+#define PHYS_WallR   2
+#define PHYS_NetL    3
+#define PHYS_NetR    4
+
+// PHYS_SEGMENT builds: the flight between two contacts is a parabola kept in
+// 16.16 fixed point, px and px per step. Gravity and Vy are kept in 1/2^24
+// px: in 16.16 the rounding of A alone would put the ball 0.8 px off in 500
+// steps, and a slow bounce with Vy rounded to 16.16 lands a step early
+#define PHYS_SegA    Scene.SegA   // Vy lost per step
+#define PHYS_SegC    Scene.SegC   // y lost per step
+#define PHYS_SegMax  1024         // Steps looked ahead for a contact, no long overflow
+
+// Autoplayer boxes (defaults): it hits within AUTO_Wall of its wall, or lower
+// than L_AUTO_Y / R_AUTO_Y and within AUTO_Net of the net
+#define AUTO_Wall    20
+#define AUTO_Net     20
 #define L_AUTO_Y     50
 #define R_AUTO_Y     55
 
+// Court sanity, COURT_check()
+#define COURT_Magic  0xC1         // EEPROM block tag, version 1
+#define COURT_Hit    7            // Hit zone starts this far from the net
+#define COURT_ViewMin 63          // Smallest view, DAC codes - 1
+
+#define TUNE_Magic   0xA1         // EEPROM block tag, version 1
+
 /* I/O CONFIGS:
  * RA  AN  I/O A/D Func
  * RA0 AN0 O   D   Relay
@@ -68,6 +148,9 @@
  * RA4 --- I   D   BTN R
  * RA5 AN4 I   D   MODE0
  * RA6 --- I   D   MODE1
+ *
+ * With CLOCK_HSPLL RA6 is OSC2: MODE1 is the left knob at power on instead,
+ * past half way is 1 (see nModeKnob).
  */
 
 // Vertical DAC
@@ -78,19 +161,40 @@
 #define H_Read      PORTC
 #define H_Write     LATC
 #define H_Dir       TRISC
+#if defined(UART_Enabled)
+// RC6/RC7 belong to the USART: the H ladder is wired to RC0-RC5 as its six
+// most significant bits and gets x >> 2
+#define H_Code(v)   ((unsigned char) (v) >> 2)
+#else
+#define H_Code(v)   (v)
+#endif
 
 // Player LEFT (0)
-#define L_Btn      PORTAbits.RA2
+#define L_Pin      PORTAbits.RA2
 #define L_Btn_Dir  TRISAbits.TRISA2
 #define L_ADC      3 // RA3/AN3
 #define L_ADC_Dir  TRISAbits.TRISA3
 
 // Player RIGHT (1)
-#define R_Btn      PORTAbits.RA4
+#define R_Pin      PORTAbits.RA4
 #define R_Btn_Dir  TRISAbits.TRISA4
 #define R_ADC      1 // RA1/AN1
 #define R_ADC_Dir  TRISAbits.TRISA1
 
+#if defined(LINK)
+// Linked: knobs and buttons go to the link, the game sees the inputs of the
+// step (the same on both boards)
+#define L_Btn      ((LINK_In[0] & LINK_Btn) ? 0 : 1)
+#define R_Btn      ((LINK_In[1] & LINK_Btn) ? 0 : 1)
+#define L_Knob     nKnob[0]
+#define R_Knob     nKnob[1]
+#else
+#define L_Btn      L_Pin
+#define R_Btn      R_Pin
+#define L_Knob     L_angle
+#define R_Knob     R_angle
+#endif
+
 // Relay pin (used to turn on or off the oscilloscope)
 #define RELAY_Pin  LATAbits.LATA0
 #define RELAY_Dir  TRISAbits.TRISA0
@@ -98,8 +202,13 @@
 // Mode pins (inputs)
 #define MODE_Read1 PORTAbits.RA5
 #define MODE_Dir1  TRISAbits.TRISA5
+#if defined(CLOCK_HSPLL)
+#define MODE_Read2 nModeKnob
+#else
 #define MODE_Read2 PORTAbits.RA6
 #define MODE_Dir2  TRISAbits.TRISA6
+#endif
+#define MODE_Pins  ((unsigned char) (MODE_Read1 << 1) | MODE_Read2)
 
 // ADC
 #define ADC_Busy    ADCON0bits.NOT_DONE
@@ -118,72 +227,445 @@
 void ADC_start(unsigned char nChannel);
 float getCustomSin(unsigned char angle);
 float getCustomCos(unsigned char angle);
+void GAME_init(word iSeed);
+void GAME_frame(void);
+void GAME_step(void);
+void RALLY_step(void);
+void GAME_reset(void);
+byte GAME_sum(void);
+word GAME_rand(void);
+void GAME_seed(word iSeed);
+void MODE_enter(unsigned char nNew);
+void MODE_frameNone(void);
+void MODE_frameDebug(void);
+unsigned char HIT_player(unsigned char nDir);
+unsigned char HIT_auto(unsigned char nDir);
+unsigned char HIT_assist(unsigned char nDir);
+void STRESS_step(unsigned char i);
+void BALL_load(unsigned char i);
+void BALL_store(unsigned char i);
+unsigned int BALL_view(unsigned char i, unsigned int x8, unsigned int y8);
+void TRAIL_fill(unsigned char i, unsigned char xs, unsigned char ys);
+void TRAIL_push(unsigned char i, unsigned char xs, unsigned char ys);
+void TRAIL_draw(unsigned char i);
+void POWER_idle(void);
+void PHYS_step(void);
+void PHYS_contact(void);
+void PHYS_segment(void);
+long PHYS_segY(unsigned int n);
+long PHYS_segMul(long a, unsigned long n);
+long PHYS_fix(float f, long lOne);
+unsigned int PHYS_segSteps(long d, long v);
+void PHYS_launch(unsigned char nDir, unsigned char angle);
+unsigned int PHYS_cross(long a0, long a1, long c);
+long PHYS_lerp(long b0, long b1, unsigned int t);
 void XY_drawLineDelta(unsigned char xs, unsigned char ys, signed char dx, signed char dy);
 void XY_drawLine(unsigned char xs, unsigned char ys, unsigned char xe, unsigned char ye);
 void XY_drawLineX(signed char delta);
 void XY_drawLineY(signed char delta);
 void XY_drawGround(void);
+void COURT_load(void);
+unsigned char COURT_check(void);
+unsigned char COURT_set(unsigned char nParam, unsigned char nValue);
+void COURT_build(void);
+void TUNE_load(void);
+unsigned char TUNE_check(void);
+unsigned char TUNE_set(unsigned char nParam, unsigned char nValue);
+void TUNE_save(void);
+void TUNE_menu(void);
 void DEBUG_line_H(unsigned char delta);
 void DEBUG_line_V(unsigned char delta);
 void DEBUG_drawChar(unsigned char xin, unsigned char yin, unsigned char digit);
+void DEBUG_drawWord(unsigned char xin, unsigned char yin, unsigned int iWord);
+unsigned char DEBUG_overlayRow(unsigned char nPage, unsigned char nRow);
+unsigned char TASK_adc(void);
+unsigned char TASK_overlay(void);
+unsigned char TASK_telem(void);
 void DEBUG_drawDigit(unsigned char xin, unsigned char yin, unsigned char digit);
 
 
+/**
+ * Hot game state
+ * Everything touched on every frame lives in the access bank so the main loop
+ * and the DAC loops never pay for a MOVLB. The access bank is only 96 bytes
+ * (0x00-0x5F) so keep it for the frame-rate critical stuff, booleans are
+ * packed as bitfields. See docs/rammap.md
+ */
+typedef struct _GAME_STATE
+{
+    // Flags
+    unsigned Debug:1;
+    unsigned Mode_Auto_L:1;
+    unsigned Mode_Auto_R:1;
+    unsigned Rule_SingleHit:1;
+    unsigned Rule_DeadBall:1;
+    unsigned Side:1;
+    unsigned DeadBall:1;
+    unsigned L_Used:1;
+    unsigned R_Used:1;
+    unsigned CourtDirty:1;
+    unsigned Rally:1;
+    unsigned Tune:1;
+    unsigned TuneArm:1;
+    unsigned TuneSet:1;
+    unsigned :2;
+    // Bytes
+    byte Mode;
+    byte BallHits;
+    byte L_Angle;
+    byte R_Angle;
+} GAME_STATE;
+
+#pragma udata access ACCESS_GAME
+
+near GAME_STATE Game;
+
+// Timers, delays and big counters
+near unsigned int iDelayNewBall;  // ms
+near unsigned int iTimerIdle;     // s
+near unsigned int iPhysAcc;       // ms not yet stepped
+near unsigned char nElapsed;      // ms taken by the last frame
+
+// Ball and oscilloscope beam position
+near unsigned char xp;         // Actual ball position
+near unsigned char yp;         //
+near unsigned char x;          // Oscilloscope beam position
+near unsigned char y;          //
+
+// Dummy variables:
+near unsigned char k;
+near unsigned char m;
+near unsigned char j;
+
+// Player control
+#define L_used            Game.L_Used
+#define L_angle           Game.L_Angle
+#define R_used            Game.R_Used
+#define R_angle           Game.R_Angle
+
+// Game control
+#define nDebug            Game.Debug
+#define nMode             Game.Mode
+#define nMode_Auto_L      Game.Mode_Auto_L
+#define nMode_Auto_R      Game.Mode_Auto_R
+#define nRule_SingleHit   Game.Rule_SingleHit
+#define nRule_DeadBall    Game.Rule_DeadBall
+#define nSide             Game.Side
+#define nDeadBall         Game.DeadBall
+#define nBallHits         Game.BallHits
+
+// Court or tune changed, COURT_build() before the next frame
+#define nCourtDirty       Game.CourtDirty
+
+// Mode 0 playing back a recorded rally, RALLY_step()
+#define nRally            Game.Rally
+
+// Tuning menu up, TUNE_menu(), and its left / right button released since
+#define nTune             Game.Tune
+#define nTuneArm          Game.TuneArm
+#define nTuneSet          Game.TuneSet
+
+/**
+ * Game modes
+ * One ROM descriptor per mode: what runs every frame, who hits the ball on
+ * each side, how long before the idle timeout and what happens then.
+ * MODE_enter() copies the current one to RAM and sets the rule flags, the
+ * main loop and GAME_step() only go through the hooks.
+ */
+typedef void (*FRAME_HOOK)(void);
+typedef unsigned char (*HIT_HOOK)(unsigned char nDir);
+
+typedef struct _MODE_DESC
+{
+    FRAME_HOOK    Frame;      // Once per frame, before the idle timers
+    FRAME_HOOK    Step;       // Game step, GAME_step() or a playback of it
+    HIT_HOOK      Hit[2];     // Ball hittable on the left / right side
+    unsigned char Idle;       // Idle timeout, TIMER_Auto or TIMER_Players
+    unsigned char OnIdle;     // Next mode on idle timeout, or MODE_Sleep
+    unsigned char Flags;      // MODE_AutoL | MODE_AutoR | MODE_SingleHit | MODE_DeadBall
+} MODE_DESC;
+
+// RALLY builds play recorded rallies in the display mode
+#if defined(RALLY)
+#define MODE_stepAuto  RALLY_step
+#else
+#define MODE_stepAuto  GAME_step
+#endif
+
+rom MODE_DESC MODE_Table[MODE_Count] = {
+    // Frame           Step           Left         Right           Idle           OnIdle      Flags
+    { MODE_frameNone,  MODE_stepAuto, { HIT_auto,   HIT_auto   }, TIMER_Auto,    MODE_Sleep, MODE_AutoL | MODE_AutoR },
+    { MODE_frameDebug, GAME_step,     { HIT_player, HIT_player }, TIMER_Players, MODE_Auto,  0 },
+    { MODE_frameNone,  GAME_step,     { HIT_player, HIT_player }, TIMER_Players, MODE_Auto,  MODE_SingleHit | MODE_DeadBall },
+    { MODE_frameNone,  GAME_step,     { HIT_player, HIT_assist }, TIMER_Players, MODE_Auto,  MODE_AutoR | MODE_SingleHit | MODE_DeadBall },
+};
+
 #pragma udata
 
+MODE_DESC     Mode;                     // Current mode, copy of MODE_Table[nMode]
+unsigned char nModeSel   = 255;         // Mode selected with the pins
 
 // Position
 float xOld, yOld, xNew, yNew;  // Theoretical ball positions
-unsigned char xp = 0;          // Actual ball position
-unsigned char yp = 0;          //
-unsigned char x  = 0;          // Oscilloscope beam position
-unsigned char y  = 0;          //
 
 // Velocity
 float VxOld, VyOld, VxNew, VyNew;
 
-// Trail
-unsigned char x_Trail[Ball_Trail];
-unsigned char y_Trail[Ball_Trail];
+// Game control
+unsigned char nBalls     = 1;           // Active balls
+unsigned char nFrames    = 0;           // Frames drawn this second
+unsigned char nStressSec = 0;           // Seconds at the current ball count
+unsigned char nFps[BALL_Max];           // Frame rate per ball count
 
-// Player control
-unsigned char L_used  = 0;
-unsigned char L_angle = 0;
-unsigned char R_used  = 0;
-unsigned char R_angle = 0;
+/**
+ * Ball store
+ * Structure of arrays, one entry per ball. Ball 0 is the one in play, the
+ * others are only spawned by the stress mode. Physics works on the scalars
+ * above, BALL_load() / BALL_store() move a ball in and out of them.
+ * Own section, it doesn't fit in a bank together with the rest.
+ */
+#if defined(TRAIL_VECTOR)
+typedef struct _TRAIL
+{
+    unsigned char x[Trail_Vertices];
+    unsigned char y[Trail_Vertices];
+    unsigned char t[Trail_Vertices];   // nTrailClock when the vertex was set
+    unsigned char n;                   // Vertices in use, >= 2
+} TRAIL;
+#define TRAIL_Head(i)  (Trails[i].n - 1)
+#else
+typedef struct _TRAIL
+{
+    // X and Y in one block so DAC_points can reach Y at a fixed offset
+    unsigned char x[Ball_Trail];
+    unsigned char y[Ball_Trail];
+} TRAIL;
+#define TRAIL_Head(i)  (Ball_Trail - 1)
+#endif
+
+#pragma udata BALLS
+
+float         Ball_x[BALL_Max];
+float         Ball_y[BALL_Max];
+float         Ball_Vx[BALL_Max];
+float         Ball_Vy[BALL_Max];
+unsigned char Ball_Hits[BALL_Max];
+#if defined(BALL_SUBPIXEL)
+unsigned char Ball_Sub[BALL_Max];       // BALL_view() of the last step
+#endif
+TRAIL         Trails[BALL_Max];
+
+#if defined(PHYS_SEGMENT)
+/**
+ * Flight segment
+ * Launch point and velocity of the ball, and the step it was launched at.
+ * The position n steps later is a closed form of the same integration the
+ * float PHYS_step() does, and the first step that can touch a wall, the
+ * net, the floor or the ceiling is worked out once at launch: only that
+ * step runs the collision tests, then a new segment starts from there.
+ */
+typedef struct _SEGMENT
+{
+    long          x0, y0;      // Launch point
+    long          Vx, Vy;      // Launch velocity, Vy in 1/2^24 px
+    unsigned int  t0;          // iPhysClock at the launch point
+    unsigned int  nEnd;        // Steps after t0 of the next possible contact
+    unsigned char Valid;       // 0: start a new segment from the Old state
+} SEGMENT;
+
+#pragma udata SEGS
+
+SEGMENT       Segs[BALL_Max];
+
+#endif
+
+/**
+ * Court
+ * Geometry in game units, the 0-255 square the physics works in, and the
+ * view that maps it to DAC codes, so one firmware fits every scope. Loaded
+ * from data EEPROM at power on, ROM defaults when the block is blank or
+ * doesn't check out. COURT_build() works out everything the game and the
+ * ground drawing use from it, and only runs again when COURT_set() changed
+ * something: a frame costs the same as with constants.
+ *
+ * EEPROM at EE_Court: COURT_Magic, the COURT bytes in order, then the sum
+ * of all the bytes before it.
+ */
+typedef struct _COURT
+{
+    unsigned char NetX, NetH;           // Net
+    unsigned char BallL, BallR, BallH;  // Serve points
+    unsigned char AutoWall, AutoNet;    // Autoplayer boxes, see HIT_auto()
+    unsigned char AutoLY, AutoRY;
+    unsigned char ViewX, ViewY;         // DAC codes of the court corner (0, 0)
+    unsigned char ViewW, ViewH;         // DAC codes across the court - 1
+} COURT;
+
+#define COURT_Size   sizeof(COURT)
+#define COURT_GameSize 9          // The bytes before the view, what the game sees
+
+rom COURT COURT_Default = {
+    Net_X, Net_H, Ball_L, Ball_R, Ball_H, AUTO_Wall, AUTO_Net, L_AUTO_Y, R_AUTO_Y,
+    0, 0, 255, 255
+};
+
+// Derived from the court, COURT_build()
+typedef struct _SCENE
+{
+    // Game units, floats so the tests compare the same as with constants
+    float         NetX;               // Side change
+    float         HitL, HitR;         // Hit zones
+    float         AutoL, AutoR;       // Autoplayer boxes: near its wall,
+    float         AutoLX, AutoRX;     // or near the net
+    float         AutoLY, AutoRY;     // and low
+    float         BallL, BallR, BallH;
+    long          NetX8, NetH8;       // Net in 24.8, PHYS_contact()
+    long          NetX16;             // Net in 16.16, PHYS_segment()
+    // Physics, from the tune. C18's double is a float, the host's works
+    // them out as the constants they replace did
+    double        Grav, Force;        // g and the hit strength
+    double        GravStep;           // Vy lost per step, g * ts
+    double        GravHalf;           // y lost per step, g * ts * ts / 2
+#if defined(PHYS_SEGMENT)
+    long          SegA, SegC;         // The same in 1/2^24 px
+#endif
+    // View, 256ths of a code per game unit
+    unsigned int  ScaleX, ScaleY;
+    // Ground polyline, DAC codes and samples
+    unsigned char X0, Y0;             // Left end
+    unsigned char NetC;               // Net
+    unsigned char RunL, RunR;         // Left end to the net, net to the right end
+    unsigned char RunUp;              // Up the net
+#if defined(RALLY)
+    unsigned char Rally;              // 1: rally.c was recorded on this court
+#endif
+} SCENE;
+
+// Game units to DAC codes
+#define VIEW_x(v)  ((unsigned char) (Court.ViewX + (((unsigned int) (v) * Scene.ScaleX) >> 8)))
+#define VIEW_y(v)  ((unsigned char) (Court.ViewY + (((unsigned int) (v) * Scene.ScaleY) >> 8)))
+
+/**
+ * Tune
+ * What a cabinet's scope wants for brightness and frame rate, and the feel
+ * of the ball: passes and dwell of the drawing, the trail, the idle timers
+ * and the physics. Loaded from data EEPROM at power on like the court, ROM
+ * defaults when the block is blank or doesn't check out, and set live from
+ * the tuning menu, TUNE_menu(). One byte each, TUNE_Min / TUNE_Max bound
+ * them.
+ *
+ * EEPROM at EE_Tune: TUNE_Magic, the TUNE bytes in order, then the sum of
+ * all the bytes before it.
+ */
+typedef struct _TUNE
+{
+    unsigned char NetRepeat;          // XY_drawGround() passes per frame
+    unsigned char BallRepeat;         // DAC_dwell() samples of the ball
+    unsigned char TrailDwell;         // DAC_points() delay loops per trail dot
+    unsigned char BallTrail;          // Trail length, steps
+    unsigned char Idle[2];            // Idle timeouts, 10 s: TIMER_Auto, TIMER_Players
+    unsigned char Gravity, Force;     // Physics, hundredths
+} TUNE;
+
+#define TUNE_Size    sizeof(TUNE)
+
+// Offset of BallRepeat. BALL_SUBPIXEL builds draw the ball with
+// DAC_dwellSub(), DAC_SubSamples samples whatever the tune says, so the
+// menu leaves it out there
+#define TUNE_BallRepeat  1
+
+// Idle timeout in s, n is TIMER_Auto or TIMER_Players
+#define TUNE_idle(n) ((unsigned int) Tune.Idle[n] * 10)
+
+rom TUNE TUNE_Default = {
+    Net_Repeat, Ball_Repeat, Trail_Dwell, Ball_Trail,
+    { TIMER_Mode_Auto / 10, TIMER_Mode_Players / 10 }, Ball_Gravity, Ball_Force
+};
+rom unsigned char TUNE_Min[TUNE_Size] = { 1,  1,  1,   2,          1,   1,   20,  50 };
+rom unsigned char TUNE_Max[TUNE_Size] = { 8,  64, 120, Ball_Trail, 255, 255, 200, 250 };
+
+#pragma udata SCENE
+
+COURT         Court;
+SCENE         Scene;
+TUNE          Tune;
+
+#pragma udata
+
+#if defined(PHYS_SEGMENT)
+SEGMENT       Seg;                // Segment of the loaded ball
+unsigned int  iPhysClock = 0;     // Game steps, wraps
+#define PHYS_restart()  Seg.Valid = 0
+#else
+#define PHYS_restart()
+#endif
+
+/**
+ * Ball spot
+ * BALL_SUBPIXEL builds place it in 1/8 of a DAC code: the dwell samples
+ * alternate between two neighbouring codes, so a slow ball glides instead of
+ * jumping a whole code at a time. Same number of samples, 11 cycles each
+ * instead of 6. The trail stays on whole codes, one sample per dot can't be
+ * dithered.
+ */
+#if defined(BALL_SUBPIXEL)
+#define BALL_draw(i, px, py)  DAC_dwellSub(px, py, Ball_Sub[i])
+#else
+#define BALL_draw(i, px, py)  DAC_dwell(px, py, Tune.BallRepeat)
+#endif
 
 // Game control
-unsigned char nDebug  = 0;
-unsigned char nMode   = 255;
-unsigned char nMode_Auto_L    = 0;
-unsigned char nMode_Auto_R    = 0;
-unsigned char nRule_SingleHit = 0;
-unsigned char nRule_DeadBall  = 0;
-unsigned char nSide      = 0;
-unsigned char nDeadBall  = 0;
 unsigned char nBallCount = 0;
-unsigned char nBallHits  = Ball_MaxHits + 1;
-
-// Timers, delays and big counters
-unsigned int iDelayNewBall = Ball_Wait;
-unsigned int iTimerIdle    = TIMER_Mode_Auto;
+#if defined(CLOCK_HSPLL)
+unsigned char nModeKnob  = 0;           // MODE1, latched from the left knob at power on
+#endif
+unsigned char nTrailClock = 0;     // Game steps, wraps
+word          iRandState  = 1;     // GAME_rand()
+
+#if defined(RALLY)
+// Rally playback
+unsigned int  iRally;             // Next RALLY_Data byte
+unsigned int  iRallyX, iRallyY;   // Ball, game units 8.8
+int           iRallyVx, iRallyVy; // 8.8 per step
+unsigned char nRallyLeft;         // Steps left in the record
+unsigned char nRallyWait;         // 1: the record is a RALLY_Wait
+#endif
 
 // Dummy variables:
-unsigned char k = 0;
-unsigned char m = 0;
-unsigned char j = 0;
 unsigned int  iVal = 0;
 
-// ADC related
-unsigned char ADC_CurrentPlayer = 0;
+// Main loop tasks, see task.h
+PT            PtAdc, PtOverlay;
+unsigned char nOverlayPage;       // Debug page being drawn, DEBUG_Page*
+unsigned char nOverlayRow;
+unsigned char nTuneSel   = 0;           // TUNE byte the menu points at
+#if defined(TELEMETRY)
+PT            PtTelem;
+#endif
+
+// Latency, Timer0 ticks (TIMER_TicksPerMs per ms)
+unsigned int  iLatStart = 0;   // Ticks when the measurement started
+unsigned int  iLatBoot  = 0;   // Power on to end of first frame
+unsigned int  iLatWake  = 0;   // Wake up to end of first frame
+unsigned char nLatPending = 1; // 1: boot, 2: wake
+
+#if defined(LINK)
+unsigned char nKnob[2];        // Local knob readings, left and right
+#endif
 
 #pragma code
 
 void main (void)
 {
+    // Timing first, power on to first frame is measured from here
+    TIMER_init();
+    iLatStart = TIMER_ticks();
+
     // Inputs
     MODE_Dir1  = IN;
+#if defined(MODE_Dir2)
     MODE_Dir2  = IN;
+#endif
     L_Btn_Dir  = IN;
     L_ADC_Dir  = IN;
     R_Btn_Dir  = IN;
@@ -197,7 +679,7 @@ void main (void)
 	V_Dir      = OUT_ALL;
 	H_Dir      = OUT_ALL;
 	V_Write    = 0;
-	H_Write    = 0;
+	H_Write    = H_Code(0);
     
     // ADC I/O
     ADC_CfgIo_Reg = ADC_CfgIo_Val;
@@ -214,488 +696,1218 @@ void main (void)
     while (ADC_Busy) {
         // We need to wait for the conversion
     }
-    // Seed rand, used for autoplayers
-    srand(ADC_Result);
-
-    // Game init
-	nSide = 0;
-	xOld  = 0;
-	yOld  = 0;
-    VxOld = 0;
-	VyOld = 0;
-	xNew  = 0;
-	yNew  = 0;
-    VxNew = 0;
-	VyNew = 0;
+#if defined(CLOCK_HSPLL)
+    // No MODE1 pin with the crystal: the left knob turned past half way at
+    // power on selects the odd modes, until the next reset
+    nModeKnob = (unsigned char) (ADC_Result >> 15);
+#endif
+    // Game init, GAME_rand is used for autoplayers
+    GAME_init(ADC_Result);
+
+    PROF_init();
+    TELEM_init();
+    LINK_init(GAME_rand() ^ TIMER_ticks());
 
     // main loop
 	for (;;) {
-        // Handle mode
-        // Note: I have them inverted in the switch
-        m = (unsigned char) (MODE_Read1 << 1) & MODE_Read2;
-        if (nMode != m){
-            nMode = m;
-            nBallHits = Ball_MaxHits + 1;
+        PROF_frame();
+        GAME_frame();
+
+        // Draw ball trails and balls, the last trail point is the ball.
+        // Knobs, overlay and telemetry run in slices in between
+        for (j = 0; j < nBalls; j++){
+            TRAIL_draw(j);
+            PROF_stage(PROF_Trail);
+            if (j == 0){
+                PROF_latPhoton((unsigned char) (nMode * 2 + nDebug));
+            }
+            BALL_draw(j, Trails[j].x[TRAIL_Head(j)], Trails[j].y[TRAIL_Head(j)]);
+            PROF_stage(PROF_Ball);
+            TASK_run();
+        }
+        if (iDelayNewBall > 0){
+            // Brighter while waiting to be served
+            BALL_draw(0, xp, yp);
+            PROF_stage(PROF_Ball);
+            TASK_run();
+        }
+
+        
+		//Draw Ground and Net
+		for (k = Tune.NetRepeat; k > 0; k--) {
+           XY_drawGround();
+           PROF_stage(PROF_Ground);
+           TASK_run();
+		}
 
-            // Mode: Auto
-            if (nMode == 0){
-                nRule_SingleHit = 0;
-                nRule_DeadBall  = 0;
-                nMode_Auto_L    = 1;
-                nMode_Auto_R    = 1;
-                iTimerIdle      = TIMER_Mode_Auto;
+        // First frame after power on or wake up is out
+        if (nLatPending){
+            if (nLatPending == 1){
+                iLatBoot = TIMER_ticks() - iLatStart;
             }
-            // Mode: 2P Original (No rules)
-            else if (nMode == 1){
-                nRule_SingleHit = 0;
-                nRule_DeadBall  = 0;
-                nMode_Auto_L    = 0;
-                nMode_Auto_R    = 0;
-                iTimerIdle      = TIMER_Mode_Players;
+            else{
+                iLatWake = TIMER_ticks() - iLatStart;
             }
-            // Mode: 2P with Rules
-            else if (nMode == 2){
-                nRule_SingleHit = 1;
-                nRule_DeadBall  = 1;
-                nMode_Auto_L    = 0;
-                nMode_Auto_R    = 0;
-                iTimerIdle      = TIMER_Mode_Players;
+            nLatPending = 0;
+        }
+
+        // Whatever the tasks have left for this frame
+        TASK_flush();
+        
+        x = 0;
+        y = Scene.NetC;
+        V_Write = 0;
+        H_Write = H_Code(Scene.NetC);
+        
+        /*
+        y = 190;
+        x = 0;
+        V_Write = y;
+        H_Write = x;
+        DEBUG_line_V(64);
+        V_Write = (nSide > 0) ? y + 50 : y;
+        DEBUG_line_H(20);
+        DEBUG_line_V(64);
+        V_Write = (nDeadBall > 0) ? y + 50 : y;
+        DEBUG_line_H(20);
+        DEBUG_line_V(64);
+        V_Write = y + (unsigned char) nBallHits / 25;
+        DEBUG_line_H(20);
+        DEBUG_line_V(64);
+        V_Write = y + (unsigned char) (iDelayNewBall >> 16) / 25;
+        DEBUG_line_H(30);
+        DEBUG_line_V(64);
+        V_Write = y + (unsigned char) (iDelayNewBall % 255) / 25;
+        DEBUG_line_H(30);
+        DEBUG_line_V(64);
+        
+        DEBUG_drawPlayerL(0,   120);
+        DEBUG_drawPlayerR(127, 120);
+        
+        */
+
+	}
+
+}
+
+/**
+ * Game init
+ * Power on state. The access bank is not initialized by the startup code,
+ * everything in it is set here, then the court is loaded and the game is
+ * seeded and reset.
+ */
+void GAME_init(word iSeed){
+    Game.Debug          = 0;
+    Game.Mode_Auto_L    = 0;
+    Game.Mode_Auto_R    = 0;
+    Game.Rule_SingleHit = 0;
+    Game.Rule_DeadBall  = 0;
+    Game.Side           = 0;
+    Game.DeadBall       = 0;
+    Game.L_Used         = 0;
+    Game.R_Used         = 0;
+    Game.CourtDirty     = 0;
+    Game.Rally          = 0;
+    Game.Tune           = 0;
+    Game.TuneArm        = 0;
+    Game.TuneSet        = 0;
+    Game.Mode           = 255;
+    Game.BallHits       = Ball_MaxHits + 1;
+    Game.L_Angle        = 0;
+    Game.R_Angle        = 0;
+    iDelayNewBall = Ball_Wait;
+    iTimerIdle    = TIMER_Mode_Auto;
+    iPhysAcc      = 0;
+    nElapsed      = 0;
+    xp = 0;
+    yp = 0;
+    x  = 0;
+    y  = 0;
+    k  = 0;
+    m  = 0;
+    j  = 0;
+
+    TUNE_load();
+    COURT_load();
+    GAME_seed(iSeed);
+    GAME_reset();
+    for (m = 0; m < BALL_Max; m++){
+        nFps[m] = 0;
+    }
+
+    PT_INIT(&PtAdc);
+    PT_INIT(&PtOverlay);
+    TASK_init();
+    TASK_add(TASK_adc, PROF_Adc);
+    TASK_add(TASK_overlay, PROF_Debug);
+#if defined(TELEMETRY)
+    PT_INIT(&PtTelem);
+    TASK_add(TASK_telem, PROF_Debug);
+#endif
+}
+
+/**
+ * Frame logic
+ * Everything the main loop does once per frame but drawing: mode switches
+ * and idle timers, the fixed rate game steps and the stress mode ball count,
+ * then the frame's tasks (knobs, overlay, telemetry) are made pending for
+ * the main loop to run between beam segments. tools/gamesim.c runs it
+ * without a scope, and the tasks right after.
+ */
+void GAME_frame(void){
+    nElapsed = TIMER_update();
+
+    if (nCourtDirty){
+        COURT_build();
+    }
+
+#if defined(LINK)
+    // Linked: 2P with rules and no idle fallback, the link restarts the
+    // game on both boards at the same step
+    if (LINK_poll(nElapsed) == LINK_Start){
+        GAME_seed(LINK_Seed);
+        GAME_reset();
+        MODE_enter(MODE_2PRules);
+    }
+#else
+    // Handle mode: the switches moved
+    m = MODE_Pins;
+    if (m != nModeSel){
+        nModeSel = m;
+        MODE_enter(m);
+    }
+    Mode.Frame();
+    
+    // Handle timers
+    if (L_Btn == 0 || R_Btn == 0){
+        RELAY_Pin = 1;
+        // Back from the idle fallback to the selected mode
+        if (nMode != nModeSel){
+            MODE_enter(nModeSel);
+        }
+        iTimerIdle = TUNE_idle(Mode.Idle);
+    }
+    else if (iTimerIdle > 0){
+        if (TIMER_Seconds){
+            iTimerIdle--;
+        }
+    }
+    else if (Mode.OnIdle == MODE_Sleep){
+        // Turn off oscope and sleep until someone shows up
+        RELAY_Pin = 0;
+        POWER_idle();
+        RELAY_Pin = 1;
+        iTimerIdle = TUNE_idle(Mode.Idle);
+    }
+    else{
+        // Nobody playing -> fall back (to auto)
+        MODE_enter(Mode.OnIdle);
+    }
+#endif
+    PROF_stage(PROF_Mode);
+
+    // Fixed rate game steps, whatever the frame takes to draw
+    iPhysAcc += nElapsed;
+    if (iPhysAcc > PHYS_MaxLag){
+        iPhysAcc = PHYS_MaxLag;
+    }
+    while (iPhysAcc >= PHYS_Period){
+#if defined(LINK)
+        // Each board sends its own player, the step waits for the other one
+        if (!LINK_ready()){
+            break;
+        }
+        if (LINK_Side == 0){
+            LINK_begin(L_Knob | (L_Pin ? 0 : LINK_Btn));
+        }
+        else{
+            LINK_begin(R_Knob | (R_Pin ? 0 : LINK_Btn));
+        }
+        L_angle = LINK_In[0] & LINK_Angle;
+        R_angle = LINK_In[1] & LINK_Angle;
+#endif
+        iPhysAcc -= PHYS_Period;
+        Mode.Step();
+#if defined(LINK)
+        LINK_end(GAME_sum());
+#endif
+    }
+    PROF_stage(PROF_Phys);
+
+    // Frame rate, and in stress mode (debug + auto) one more ball every few seconds
+    if (nFrames < 255){
+        nFrames++;
+    }
+    if (TIMER_Seconds){
+        nFps[nBalls - 1] = nFrames;
+        nFrames = 0;
+        if (nDebug && nMode == MODE_Auto){
+            nStressSec++;
+            if (nStressSec >= STRESS_Period){
+                nStressSec = 0;
+                nBalls = (nBalls < BALL_Max) ? nBalls + 1 : 1;
+                // Spawn it resting, STRESS_step() will launch it
+                Ball_Hits[nBalls - 1] = Ball_MaxHits + 1;
+            }
+        }
+        else{
+            nBalls     = 1;
+            nStressSec = 0;
+        }
+    }
+
+    TASK_frame();
+}
+
+/**
+ * Game step
+ * Advances the game by PHYS_Period ms: side changes, new balls, serve delay,
+ * physics, hits and trail history.
+ */
+void GAME_step(void){
+    nTrailClock++;
+#if defined(PHYS_SEGMENT)
+    iPhysClock++;
+#endif
+    PROF_latStep();
+    BALL_load(0);
+
+    // Changing nSide
+    if (nSide != (xOld >= Scene.NetX)) {
+        nSide = (xOld >= Scene.NetX);
+
+        if (nSide){
+            R_used = 0;
+        }
+        else{
+            L_used = 0;
+        }
+    }
+
+    // IF ball has run out of energy, make a new ball!
+    if ( nBallHits > Ball_MaxHits ) {
+        nBallCount++;
+        nBallHits = 0;
+        nDeadBall = 0;
+        R_used    = 0;
+        L_used    = 0;
+        VxOld     = 0;
+        VyOld     = 0;
+        PHYS_restart();
+
+        iDelayNewBall  = Ball_Wait;
+
+        yOld = Scene.BallH;
+        if (nSide == 0) {
+            nSide  = 1;
+            xOld   = Scene.BallR;
+            L_used = 1;
+            if (nMode_Auto_R){
+                // We don't want to wait too much
+                iDelayNewBall  = Ball_WaitShort;
+            }
+        }
+        else {
+            nSide   = 0;
+            xOld   = Scene.BallL;
+            R_used = 1;
+            if (nMode_Auto_L){
+                // We don't want to wait too much
+                iDelayNewBall  = Ball_WaitShort;
+            }
+        }
+
+        // Fill in history
+        TRAIL_fill(0, VIEW_x(xOld), VIEW_y(yOld));
+    }
+
+    if (iDelayNewBall > 0) {
+        if (iDelayNewBall > PHYS_Period){
+            iDelayNewBall -= PHYS_Period;
+        }
+        else{
+            iDelayNewBall = 0;
+        }
+
+        if ( (nSide == 0 && L_Btn == 0) || (nSide == 1 && R_Btn == 0)){
+            iDelayNewBall = 0;
+        }
+
+        VxNew = VxOld;
+        VyNew = VyOld;
+        xNew  = xOld;
+        yNew  = yOld;
+    }
+    else {
+        PHYS_step();
+        PROF_stage(PROF_Phys);
+
+        /* Button presses and automata */
+        if ((nSide == 0 && xOld < Scene.HitL) || (nSide == 1 && xOld > Scene.HitR)) {
+            if ((nSide ? R_used : L_used) == 0 && nDeadBall == 0) {
+                Mode.Hit[nSide](nSide);
             }
-            // Mode: 1P with Rules
-            else if (nMode == 3){
-                nRule_SingleHit = 1;
-                nRule_DeadBall  = 1;
-                nMode_Auto_L    = 0;
-                nMode_Auto_R    = 1;
-                iTimerIdle      = TIMER_Mode_Players;
-            }            
         }
-        
-        // Turn on/off Debug mode
-        if (nMode == 1 
-            && iDelayNewBall > 0 
-            && nSide   == 0 
-            && L_angle == 0 
-            && R_angle == 0 
-            && L_Btn   == 0 
-            && R_Btn   == 0){
-            nDebug = nDebug ? 0 : 1;
-            iDelayNewBall = 0;
+        PROF_stage(PROF_Hit);
+    }
+
+    //Figure out which point we're going to draw.
+#if defined(BALL_SUBPIXEL)
+    iVal = BALL_view(0, (unsigned int) (xNew * 8), (unsigned int) (yNew * 8));
+    xp   = (unsigned char) (iVal >> 8);
+    yp   = (unsigned char) iVal;
+#else
+    xp =  VIEW_x(floor(xNew));
+    yp =  VIEW_y(floor(yNew));
+#endif
+
+    TRAIL_push(0, xp, yp);
+
+    // Get ready for the next iteration
+    // New values become old values
+    VxOld = VxNew;
+    VyOld = VyNew;
+    xOld  = xNew;
+    yOld  = yNew;
+    BALL_store(0);
+
+    // Stress balls
+    for (k = 1; k < nBalls; k++){
+        STRESS_step(k);
+    }
+}
+
+#if defined(RALLY)
+/**
+ * Rally playback step
+ * Mode 0 step of RALLY builds: the next step of the rallies in rally.c, a
+ * few integer adds instead of the float physics and the autoplayers, so the
+ * main loop is back to drawing that much sooner. The stress mode (debug
+ * on) and a court the rallies weren't recorded on run the live game, which
+ * serves a new ball when playback stops.
+ */
+void RALLY_step(void){
+    unsigned char b;
+
+    if (nDebug || !Scene.Rally){
+        if (nRally){
+            nRally    = 0;
+            nBallHits = Ball_MaxHits + 1;
+        }
+        GAME_step();
+        return;
+    }
+    nTrailClock++;
+    PROF_latStep();
+    if (!nRally){
+        // From the first rally, whatever the live ball was doing
+        nRally     = 1;
+        iRally     = 0;
+        nRallyLeft = 0;
+        nBalls     = 1;
+    }
+
+    if (nRallyLeft == 0){
+        b = RALLY_Data[iRally++];
+        if (b == RALLY_Wrap){
+            iRally = 0;
+            b = RALLY_Data[iRally++];
+        }
+        if (b == RALLY_Serve){
+            iRallyX = (unsigned int) RALLY_Data[iRally++] << 8;
+            iRallyY = (unsigned int) RALLY_Data[iRally++] << 8;
+            nBallCount++;
+            TRAIL_fill(0, VIEW_x(iRallyX >> 8), VIEW_y(iRallyY >> 8));
+            b = RALLY_Data[iRally++];
+        }
+        nRallyLeft = RALLY_Data[iRally++];
+        nRallyWait = (b == RALLY_Wait);
+        if (b == RALLY_Fly){
+            iRallyX   = (unsigned int) RALLY_Data[iRally++] << 8;
+            iRallyX  |= RALLY_Data[iRally++];
+            iRallyY   = (unsigned int) RALLY_Data[iRally++] << 8;
+            iRallyY  |= RALLY_Data[iRally++];
+            iRallyVx  = (int) (signed char) RALLY_Data[iRally++] * 256;
+            iRallyVx |= RALLY_Data[iRally++];
+            iRallyVy  = (int) (signed char) RALLY_Data[iRally++] * 256;
+            iRallyVy |= RALLY_Data[iRally++];
+        }
+    }
+    else if (!nRallyWait){
+        iRallyX  += iRallyVx;
+        iRallyY  += iRallyVy;
+        iRallyVy -= RALLY_Gravity;
+    }
+    nRallyLeft--;
+    // Brighter while waiting, as when served live
+    iDelayNewBall = nRallyWait ? (unsigned int) nRallyLeft * PHYS_Period : 0;
+
+    // The live ball follows the playback: the side, the overlay, the
+    // telemetry and the live game taking over see where it really is
+    xNew = (float) iRallyX * (1.0 / 256);
+    yNew = (float) iRallyY * (1.0 / 256);
+    if (nRallyWait){
+        VxNew = 0;
+        VyNew = 0;
+    }
+    else{
+        VxNew = (float) iRallyVx * (1.0 / 256);
+        VyNew = (float) iRallyVy * (1.0 / 256);
+    }
+    VxOld = VxNew;
+    VyOld = VyNew;
+    xOld  = xNew;
+    yOld  = yNew;
+    nSide = (xOld >= Scene.NetX);
+    BALL_store(0);
+
+#if defined(BALL_SUBPIXEL)
+    iVal = BALL_view(0, iRallyX >> 5, iRallyY >> 5);
+    xp   = (unsigned char) (iVal >> 8);
+    yp   = (unsigned char) iVal;
+#else
+    xp = VIEW_x(iRallyX >> 8);
+    yp = VIEW_y(iRallyY >> 8);
+#endif
+    TRAIL_push(0, xp, yp);
+}
+#endif
+
+/**
+ * Game reset
+ * Ball 0 resting, next step serves a new ball. Power on, and with LINK both
+ * boards on pairing so they start from the same state.
+ */
+void GAME_reset(void){
+    nSide     = 0;
+    nDeadBall = 0;
+    L_used    = 0;
+    R_used    = 0;
+    nBallHits = Ball_MaxHits + 1;
+    xOld  = 0;
+    yOld  = 0;
+    VxOld = 0;
+    VyOld = 0;
+    xNew  = 0;
+    yNew  = 0;
+    VxNew = 0;
+    VyNew = 0;
+    PHYS_restart();
+    for (m = 0; m < BALL_Max; m++){
+        BALL_store(m);
+        Ball_Hits[m] = 0;
+#if defined(BALL_SUBPIXEL)
+        Ball_Sub[m]  = 0;
+#endif
+    }
+    nBalls        = 1;
+    nBallCount    = 0;
+    nTrailClock   = 0;
+    iDelayNewBall = Ball_Wait;
+    iPhysAcc      = 0;
+}
+
+/**
+ * Game random numbers
+ * 16 bit xorshift with its state in RAM, so a game can be saved and replayed
+ * (the library rand() keeps its state to itself). 15 bits like rand(), the
+ * callers were written for it.
+ */
+word GAME_rand(void){
+    iRandState ^= iRandState << 7;
+    iRandState ^= iRandState >> 9;
+    iRandState ^= iRandState << 8;
+    return iRandState >> 1;
+}
+
+void GAME_seed(word iSeed){
+    // 0 would stay 0
+    iRandState = iSeed ? iSeed : 1;
+}
+
+/**
+ * Game checksum
+ * Everything a step leaves behind for the next one, for the LINK desync
+ * check. Rotate and add over the float bytes and the game flags.
+ */
+byte GAME_sum(void){
+    byte *pB;
+    byte nSum = 0;
+
+    pB = (byte *) &Ball_x[0];
+    for (m = 0; m < sizeof(float); m++){
+        nSum = ((nSum << 1) | (nSum >> 7)) + pB[m];
+    }
+    pB = (byte *) &Ball_y[0];
+    for (m = 0; m < sizeof(float); m++){
+        nSum = ((nSum << 1) | (nSum >> 7)) + pB[m];
+    }
+    pB = (byte *) &Ball_Vx[0];
+    for (m = 0; m < sizeof(float); m++){
+        nSum = ((nSum << 1) | (nSum >> 7)) + pB[m];
+    }
+    pB = (byte *) &Ball_Vy[0];
+    for (m = 0; m < sizeof(float); m++){
+        nSum = ((nSum << 1) | (nSum >> 7)) + pB[m];
+    }
+    nSum += nBallHits;
+    nSum += (byte) nSide | ((byte) nDeadBall << 1) | ((byte) L_used << 2) | ((byte) R_used << 3);
+    nSum += (byte) iDelayNewBall;
+    nSum += nBallCount;
+    return nSum;
+}
+
+/**
+ * Mode transition
+ * Switch moved, idle fallback or back from it. Sets the rule flags and the
+ * idle timer of the new mode and makes a new ball.
+ */
+void MODE_enter(unsigned char nNew){
+    nMode       = nNew;
+    Mode.Frame  = MODE_Table[nNew].Frame;
+    Mode.Step   = MODE_Table[nNew].Step;
+    Mode.Hit[0] = MODE_Table[nNew].Hit[0];
+    Mode.Hit[1] = MODE_Table[nNew].Hit[1];
+    Mode.Idle   = MODE_Table[nNew].Idle;
+    Mode.OnIdle = MODE_Table[nNew].OnIdle;
+    Mode.Flags  = MODE_Table[nNew].Flags;
+
+    nMode_Auto_L    = (Mode.Flags & MODE_AutoL)     ? 1 : 0;
+    nMode_Auto_R    = (Mode.Flags & MODE_AutoR)     ? 1 : 0;
+    nRule_SingleHit = (Mode.Flags & MODE_SingleHit) ? 1 : 0;
+    nRule_DeadBall  = (Mode.Flags & MODE_DeadBall)  ? 1 : 0;
+
+    iTimerIdle = TUNE_idle(Mode.Idle);
+    nBallHits  = Ball_MaxHits + 1;
+    nRally     = 0;
+    nTune      = 0;
+}
+
+void MODE_frameNone(void){
+}
+
+/**
+ * 2P Original frame hook
+ * Both buttons down while the serve is waiting with both knobs at 0 turns
+ * the debug mode on or off when the serve is on the left, and with the debug
+ * mode on brings up the tuning menu when it is on the right
+ */
+void MODE_frameDebug(void){
+    if (nTune){
+        TUNE_menu();
+        return;
+    }
+    if (iDelayNewBall > 0 
+        && L_angle == 0 
+        && R_angle == 0 
+        && L_Btn   == 0 
+        && R_Btn   == 0){
+        if (nSide == 0){
+            nDebug = nDebug ? 0 : 1;
+            iDelayNewBall = 0;
+        }
+        else if (nDebug){
+            // The ball plays itself while the buttons are busy with the menu
+            nTune       = 1;
+            nTuneArm    = 0;
+            nTuneSet    = 0;
+            Mode.Hit[0] = HIT_auto;
+            Mode.Hit[1] = HIT_auto;
+            iDelayNewBall = 0;
+        }
+    }
+}
+
+/**
+ * Hit hooks
+ * Called by GAME_step() when the ball is on the nDir side (0: left, 1: right)
+ * and that player may hit it. Return 1 if the ball was hit.
+ */
+unsigned char HIT_player(unsigned char nDir){
+    if (nDir == 0){
+        if (L_Btn != 0){
+            return 0;
+        }
+        PHYS_launch(0, L_angle);
+        L_used = nRule_SingleHit;
+    }
+    else{
+        if (R_Btn != 0){
+            return 0;
+        }
+        PHYS_launch(1, R_angle);
+        R_used = nRule_SingleHit;
+    }
+    nBallHits = 0;
+    return 1;
+}
+
+unsigned char HIT_auto(unsigned char nDir){
+    if (nDir == 0){
+        if (!(xOld < Scene.AutoL || (yOld < Scene.AutoLY && xOld < Scene.AutoLX))){
+            return 0;
+        }
+    }
+    else if (!(xOld > Scene.AutoR || (yOld < Scene.AutoRY && xOld > Scene.AutoRX))){
+        return 0;
+    }
+
+    // GAME_rand() is 15 bits, take the top 8
+    iVal = GAME_rand();
+    j = (unsigned char) (iVal >> 7);
+
+    if (j < 10){
+        // we have 4% chances that the automata will fuck it up totally
+        if (nDir == 0){
+            L_used = 1;
+        }
+        else{
+            R_used = 1;
+        }
+        nDeadBall = 1;
+        return 0;
+    }
+    if (j <= 50){
+        // We have 16% (40 / 255) chance that automata will not reply in this iteration
+        // but we are not making it deadball, it should let the ball continue
+        // and hit it the next time possibly
+        return 0;
+    }
+
+    j = ((unsigned char) (iVal & 31) + Angle_Delta + Angle_Min);
+
+    PHYS_launch(nDir, j);
+    if (nDir == 0){
+        L_used = nRule_SingleHit;
+    }
+    else{
+        R_used = nRule_SingleHit;
+    }
+    nBallHits = 0;
+    return 1;
+}
+
+/**
+ * 1P: the automata plays, a player can still take over with the button
+ */
+unsigned char HIT_assist(unsigned char nDir){
+    if (HIT_player(nDir)){
+        return 1;
+    }
+    return HIT_auto(nDir);
+}
+
+/**
+ * Stress ball step
+ * Same physics as the ball in play but no players: bounces until it runs out
+ * of energy and then gets launched again from one side at random.
+ * The game flags PHYS_step() touches are kept aside meanwhile.
+ */
+void STRESS_step(unsigned char i){
+    unsigned char nSaveSide     = nSide;
+    unsigned char nSaveDeadBall = nDeadBall;
+    unsigned char nSaveHits     = nBallHits;
+
+    BALL_load(i);
+    nBallHits = Ball_Hits[i];
+
+    if (nBallHits > Ball_MaxHits){
+        iVal = GAME_rand();
+        nBallHits = 0;
+        yOld = Scene.BallH;
+        if (iVal & 1){
+            xOld = Scene.BallR;
+        }
+        else{
+            xOld = Scene.BallL;
+        }
+        PHYS_launch(iVal & 1, (unsigned char) ((iVal >> 8) & 31) + Angle_Delta + Angle_Min);
+        VxOld = VxNew;
+        VyOld = VyNew;
+        TRAIL_fill(i, VIEW_x(xOld), VIEW_y(yOld));
+    }
+
+    nSide = (xOld >= Scene.NetX);
+    PHYS_step();
+#if defined(BALL_SUBPIXEL)
+    iVal = BALL_view(i, (unsigned int) (xNew * 8), (unsigned int) (yNew * 8));
+    TRAIL_push(i, (unsigned char) (iVal >> 8), (unsigned char) iVal);
+#else
+    TRAIL_push(i, VIEW_x(floor(xNew)), VIEW_y(floor(yNew)));
+#endif
+
+    VxOld = VxNew;
+    VyOld = VyNew;
+    xOld  = xNew;
+    yOld  = yNew;
+    BALL_store(i);
+    Ball_Hits[i] = nBallHits;
+
+    nSide     = nSaveSide;
+    nDeadBall = nSaveDeadBall;
+    nBallHits = nSaveHits;
+}
+
+void BALL_load(unsigned char i){
+    xOld  = Ball_x[i];
+    yOld  = Ball_y[i];
+    VxOld = Ball_Vx[i];
+    VyOld = Ball_Vy[i];
+#if defined(PHYS_SEGMENT)
+    Seg   = Segs[i];
+#endif
+}
+
+void BALL_store(unsigned char i){
+    Ball_x[i]  = xOld;
+    Ball_y[i]  = yOld;
+    Ball_Vx[i] = VxOld;
+    Ball_Vy[i] = VyOld;
+#if defined(PHYS_SEGMENT)
+    Segs[i]    = Seg;
+#endif
+}
+
+#if defined(BALL_SUBPIXEL)
+/**
+ * View position of ball i at (x8, y8), game units in 1/8, for
+ * DAC_dwellSub(). The position is scaled in 1/8 of a DAC code in one go,
+ * then split: the whole codes are returned (X high byte, Y low byte) and the
+ * eighths go to Ball_Sub[i] (X high nibble, Y low nibble). Scaling the whole
+ * part and the fraction apart would lose the fraction of a code the whole
+ * part scales to.
+ */
+unsigned int BALL_view(unsigned char i, unsigned int x8, unsigned int y8){
+    unsigned int iX, iY;
+
+    iX = (unsigned int) (((unsigned long) x8 * Scene.ScaleX) >> 8);
+    iY = (unsigned int) (((unsigned long) y8 * Scene.ScaleY) >> 8);
+    Ball_Sub[i] = (unsigned char) (((iX & 7) << 4) | (iY & 7));
+    return ((unsigned int) (unsigned char) (Court.ViewX + (iX >> 3)) << 8)
+         | (unsigned char) (Court.ViewY + (iY >> 3));
+}
+#endif
+
+#if defined(TRAIL_VECTOR)
+
+/**
+ * Vector trail
+ * Instead of one dot per step only the points where the path bends are kept
+ * and TRAIL_draw() joins them with DAC_line(). The last vertex (the head)
+ * follows the ball, the one before is fixed. The head is left behind as a
+ * new vertex when the ball moved more than Trail_Dev away from the line
+ * between the fixed vertex and the ball, or Trail_Span steps went by.
+ * The tail segment goes away once it is older than the dotted trail.
+ */
+void TRAIL_fill(unsigned char i, unsigned char xs, unsigned char ys){
+    Trails[i].x[0] = xs;
+    Trails[i].y[0] = ys;
+    Trails[i].t[0] = nTrailClock;
+    Trails[i].x[1] = xs;
+    Trails[i].y[1] = ys;
+    Trails[i].t[1] = nTrailClock;
+    Trails[i].n    = 2;
+}
+
+void TRAIL_drop(TRAIL *pT){
+    for (m = 0; m < pT->n - 1; m++){
+        pT->x[m] = pT->x[m + 1];
+        pT->y[m] = pT->y[m + 1];
+        pT->t[m] = pT->t[m + 1];
+    }
+    pT->n--;
+}
+
+void TRAIL_push(unsigned char i, unsigned char xs, unsigned char ys){
+    TRAIL *pT = &Trails[i];
+    int   dx, dy, hx, hy;
+    long  lCross, lLen;
+    unsigned char v;
+
+    // Ball and head relative to the fixed vertex
+    v  = pT->n - 2;
+    dx = (int) xs - pT->x[v];
+    dy = (int) ys - pT->y[v];
+    hx = (int) pT->x[v + 1] - pT->x[v];
+    hy = (int) pT->y[v + 1] - pT->y[v];
+
+    // |cross| / |d| is the distance from the head to the line, |d| is taken
+    // as |dx| + |dy| which is never less so no division nor square root
+    lCross = (long) dx * hy - (long) dy * hx;
+    if (lCross < 0){
+        lCross = -lCross;
+    }
+    lLen = (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+
+    if (lCross > Trail_Dev * lLen
+        || (unsigned char) (nTrailClock - pT->t[v]) >= Trail_Span){
+        // Leave the head there
+        if (pT->n == Trail_Vertices){
+            TRAIL_drop(pT);
+        }
+        pT->n++;
+    }
+    v = pT->n - 1;
+    pT->x[v] = xs;
+    pT->y[v] = ys;
+    pT->t[v] = nTrailClock;
+
+    // Same length as the dotted trail
+    while (pT->n > 2 && (unsigned char) (nTrailClock - pT->t[1]) >= Tune.BallTrail){
+        TRAIL_drop(pT);
+    }
+}
+
+void TRAIL_draw(unsigned char i){
+    for (m = 1; m < Trails[i].n; m++){
+        DAC_line(Trails[i].x[m - 1], Trails[i].y[m - 1], Trails[i].x[m], Trails[i].y[m]);
+    }
+}
+
+#else
+
+void TRAIL_fill(unsigned char i, unsigned char xs, unsigned char ys){
+    for (m = 0; m < Ball_Trail; m++){
+        Trails[i].x[m] = xs;
+        Trails[i].y[m] = ys;
+    }
+}
+
+void TRAIL_push(unsigned char i, unsigned char xs, unsigned char ys){
+    // Shift the values in the stack
+    for (m = 0; m < Ball_Trail - 1; m++){
+        Trails[i].x[m] = Trails[i].x[m + 1];
+        Trails[i].y[m] = Trails[i].y[m + 1];
+    }
+    // Push the current point to the stack
+    Trails[i].x[Ball_Trail - 1] = xs;
+    Trails[i].y[Ball_Trail - 1] = ys;
+}
+
+// The newest Tune.BallTrail points, the store always keeps Ball_Trail
+void TRAIL_draw(unsigned char i){
+    DAC_points(Trails[i].x + (Ball_Trail - Tune.BallTrail), Tune.BallTrail, Ball_Trail, Tune.TrailDwell);
+}
+
+#endif
+
+/**
+ * Idle
+ * The scope is off: stop drawing and SLEEP until a button is pressed or the
+ * mode switches move. Buttons and switches are on PORTA, which can't wake the
+ * PIC (interrupt on change is RB4-RB7 and INT0-2 are RB0-RB2, all of them the
+ * vertical DAC), so the software enabled watchdog wakes it up every ~72 ms to
+ * take a look. Timer0 is stopped while sleeping.
+ */
+void POWER_idle(void){
+    m = MODE_Pins;
+
+    // Park the beam, no current through the ladders, ADC off
+    V_Write = 0;
+    H_Write = H_Code(0);
+    ADCON0bits.ADON = 0;
+
+    WDTCONbits.SWDTEN = 1;
+    for (;;){
+        Sleep();
+        if (L_Pin == 0 || R_Pin == 0 || MODE_Pins != m){
+            break;
+        }
+    }
+    WDTCONbits.SWDTEN = 0;
+
+    // Back to work, TASK_adc() turns the converter back on
+    iLatStart   = TIMER_ticks();
+    nLatPending = 2;
+}
+
+/**
+ * Physics step
+ * Integrates one time step from the Old state into the New state and
+ * PHYS_contact() resolves walls, net, floor and ceiling. This is the whole
+ * physics in one place so it can be swapped or compared against a new
+ * implementation, same inputs (Old state, nSide, nRule_DeadBall) must give
+ * same outputs (New state, nDeadBall, nBallHits).
+ */
+#if defined(PHYS_SEGMENT)
+
+/**
+ * PHYS_SEGMENT builds: New state from the segment, collision tests only on
+ * the step worked out when the segment started. The closed form is the float
+ * integration below done in integers, y lost n(n-1)/2 * A + n * C after n
+ * steps, so splitting a flight in two segments gives the very same path.
+ */
+void PHYS_step(void){
+    unsigned int n;
+
+    if (!Seg.Valid){
+        PHYS_segment();
+    }
+    n = iPhysClock - Seg.t0;
+
+    xNew  = (float) (Seg.x0 + Seg.Vx * (long) n) / 65536;
+    yNew  = (float) PHYS_segY(n) / 65536;
+    VxNew = (float) Seg.Vx / 65536;
+    VyNew = (float) (Seg.Vy - PHYS_SegA * (long) n) / 16777216;
+
+    if (n >= Seg.nEnd){
+        // Bounce or not, the next step starts a new segment from here
+        PHYS_contact();
+        PHYS_restart();
+    }
+}
+
+/**
+ * New segment from the Old state, launched at the previous step
+ */
+void PHYS_segment(void){
+    long n, m, lo, hi;
+
+    Seg.t0 = iPhysClock - 1;
+    Seg.x0 = PHYS_fix(xOld, 65536);
+    Seg.y0 = PHYS_fix(yOld, 65536);
+    Seg.Vx = PHYS_fix(VxOld, 65536);
+    Seg.Vy = PHYS_fix(VyOld, 16777216);
+    Seg.Valid = 1;
+    n = PHYS_SegMax;
+
+    // Walls and net: x is linear. Same tests as PHYS_contact(), which looks
+    // at x in 8.8 cut towards 0
+    if (Seg.Vx < 0){
+        m = PHYS_segSteps(Seg.x0 + 256, -Seg.Vx);
+        n = (m < n) ? m : n;
+        if (nSide){
+            m = PHYS_segSteps(Seg.x0 - (Scene.NetX16 - 1), -Seg.Vx);
+            n = (m < n) ? m : n;
+        }
+    }
+    else if (Seg.Vx > 0){
+        m = PHYS_segSteps((255L * 256 + 1) * 256 - Seg.x0, Seg.Vx);
+        n = (m < n) ? m : n;
+        if (!nSide){
+            m = PHYS_segSteps(Scene.NetX16 + 256 - Seg.x0, Seg.Vx);
+            n = (m < n) ? m : n;
         }
-        
-        // Handle timers
-        if (L_Btn == 0 || R_Btn == 0){
-            RELAY_Pin = 1;
-            // Reset idle timer according to mode
-            if (nMode == 0){
-                iTimerIdle = TIMER_Mode_Auto;
+    }
+
+    // Floor and ceiling: y goes up to the top at step m, down after it
+    m = (Seg.Vy - PHYS_SegC) / PHYS_SegA + 1;
+    if (m < 1){
+        m = 1;
+    }
+    if (m > n){
+        m = n;
+    }
+    if (PHYS_segY((unsigned int) m) >= 255L * 65536){
+        // First step at the ceiling, on the way up
+        lo = 1;
+        hi = m;
+        while (lo < hi){
+            m = (lo + hi) >> 1;
+            if (PHYS_segY((unsigned int) m) >= 255L * 65536){
+                hi = m;
             }
             else{
-                iTimerIdle = TIMER_Mode_Players;
+                lo = m + 1;
             }
         }
-        else if (iTimerIdle > 0){
-            iTimerIdle--;
-        }
-        else{
-            if (nMode == 0){
-                // Mode: Auto -> Turn off oscope
-               RELAY_Pin = 0;
+        n = lo;
+    }
+    else if (PHYS_segY(1) <= 0){
+        n = 1;
+    }
+    else if (PHYS_segY((unsigned int) n) <= 0){
+        // First step on the floor, on the way down
+        lo = m;
+        hi = n;
+        while (lo < hi){
+            m = (lo + hi) >> 1;
+            if (PHYS_segY((unsigned int) m) <= 0){
+                hi = m;
             }
             else{
-               // Mode: Players  -> switch to auto
-               nMode = 0;
-               iTimerIdle = TIMER_Mode_Auto;
+                lo = m + 1;
             }
         }
-        
-        // Changing nSide
-		if (nSide != (xOld >= Net_X)) {
-			nSide = (xOld >= Net_X);
-
-			if (nSide){
-                R_used = 0;
-			}
-            else{
-                L_used = 0;
-            }
-		}
+        n = lo;
+    }
+    Seg.nEnd = (unsigned int) n;
+}
 
-		// IF ball has run out of energy, make a new ball!
-		if ( nBallHits > Ball_MaxHits ) {
-            nBallCount++;
-			nBallHits = 0;
-			nDeadBall = 0;
-			R_used    = 0;
-			L_used    = 0;
-            VxOld     = 0;
-            VyOld     = 0;
-
-			iDelayNewBall  = Ball_Wait;
-
-            yOld = (float) Ball_H;
-			if (nSide == 0) {
-                nSide  = 1;
-				xOld   = (float) Ball_R;
-				L_used = 1;
-                if (nMode_Auto_R){
-                    // We don't want to wait too much
-                    iDelayNewBall  = Ball_WaitShort;
-                }
-			}
-			else {
-                nSide   = 0;
-				xOld   = (float) Ball_L;
-				R_used = 1;
-                if (nMode_Auto_L){
-                    // We don't want to wait too much
-                    iDelayNewBall  = Ball_WaitShort;
-                }
-			}
-
-            // Fill in history
-			m = 0;
-			while (m < Ball_Trail) {
-				x_Trail[m] = xOld;
-				y_Trail[m] = yOld;
-				m++;
-			}
-		}
+/**
+ * y of the segment n steps after the launch
+ */
+long PHYS_segY(unsigned int n){
+    return Seg.y0 + PHYS_segMul(Seg.Vy, n)
+         - PHYS_segMul(PHYS_SegC, n)
+         - PHYS_segMul(PHYS_SegA, ((unsigned long) n * (n - 1)) >> 1);
+}
 
-		// If ADC conversion has finished
-        if (ADC_Busy == 0) {
-            // Read ADC value (10 bits right aligned 1111 1111 1100 0000)
-            // We only care about the 8 most significant bits
-			iVal = ADC_Result >> 8;
-            // 128 values allowed, hence 7 bits are actually used
-            iVal = iVal >> 1;
-
-			// We are using *ONE* ADC, but sequentially multiplexing it to sample
-			// the two different input lines.	
-			if (ADC_CurrentPlayer == 0) {
-                
-				L_angle =  iVal;
-                // Start next conversion
-                ADC_CurrentPlayer = 1;
-                ADC_start(R_ADC);
-            }
-			else {
-				R_angle =  iVal;
-                // Start next conversion
-                ADC_CurrentPlayer = 0;
-                ADC_start(L_ADC);
-            }
-		}
-        
-        /* DEBUG!!!!! */
-        //L_angle = ((nBallCount & 0x07) << 2) + 31;
-        //R_angle = ((nBallCount & 0x07) << 2) + 31;
-        //R_angle = L_angle;
+/**
+ * a * n in 16.16 for a in 1/2^24 px, n up to PHYS_SegMax *
+ * (PHYS_SegMax - 1) / 2 for gravity: the top and the low byte of a are
+ * multiplied apart so neither product overflows
+ */
+long PHYS_segMul(long a, unsigned long n){
+    return (a >> 8) * (long) n + (long) (((a & 255) * n) >> 8);
+}
 
-		if (iDelayNewBall > 0) {
-			iDelayNewBall--;
+/**
+ * float to fixed point with lOne for 1 px, rounded to nearest. From 128 px
+ * up a float has 16.16's own resolution and each float add rounds to it,
+ * so x + n * Vx with Vx rounded the same way is the float build's path to
+ * the bit. Below that a float is finer, which Vy needs near the floor
+ */
+long PHYS_fix(float f, long lOne){
+    f *= lOne;
+    return (long) ((f < 0) ? f - 0.5 : f + 0.5);
+}
 
-   			if ( (nSide == 0 && L_Btn == 0) || (nSide == 1 && R_Btn == 0)){
-				iDelayNewBall = 0;
-            }
+/**
+ * Steps for a distance d at speed v > 0, rounded up, 1 to PHYS_SegMax
+ */
+unsigned int PHYS_segSteps(long d, long v){
+    if (d <= v){
+        return 1;
+    }
+    d = (d + v - 1) / v;
+    return (d > PHYS_SegMax) ? PHYS_SegMax : (unsigned int) d;
+}
 
-			m = 0;
-			while (m < Ball_Repeat) {
-				V_Write = yp;
-				H_Write = xp;
-				m++;
-			}
-
-			VxNew = VxOld;
-			VyNew = VyOld;
-			xNew  = xOld;
-			yNew  = yOld;
-		}
-		else {
-            // Physics calculations
-            // x' = x + v*t + at*t/2
-            // v' = v + a*t
-            //
-            // Horizontal (X) axis: No acceleration; a = 0.
-            // Vertical   (Y) axis: a = -g
-			xNew  = xOld + VxOld;
-			yNew  = yOld + VyOld - 0.5 * g * ts * ts;
-
-			VyNew = VyOld - g * ts;
-			VxNew = VxOld;
-
-			/* Bounce at walls */
-            // Left Wall
-			if (xNew < 0) {
-				VxNew   *= -0.25;
-				VyNew   *= 0.75;
-				xNew     = (float) 0;
-				nDeadBall = nRule_DeadBall;
-				//nBallHits  = 100;
-			}
-            // Right Wall
-			if (xNew > 255) {
-				VxNew   *= -0.25;
-                VyNew   *= 0.75;
-				xNew     = (float) 255;
-				nDeadBall = nRule_DeadBall;
-				//nBallHits  = 100;
-                
-			}
-            // Floor
-			if (yNew <= 0) {
-				yNew = (float) 0;
-				if (VyNew * VyNew < 10) {
-					nBallHits++;
-				}
-				if (VyNew < 0) {
-					VyNew *= -0.75;
-				}
-			}
-            // Ceiling
-			if (yNew >= 255) {
-				yNew = (float) 255;
-				VyNew *= -0.75;
-			}
-
-            /* Check net */
-			if (nSide) {
-                // RIGHT SIDE
-				if (xNew < Net_X) {
-					if (yNew <= Net_H) {
-						// Bounce off of net
-						VxNew   *= -0.5;
-						VyNew   *= 0.5;
-						xNew     = (float) Net_X + 1;
-						nDeadBall = nRule_DeadBall;
-					}
-				}
-			}
-            else {
-                // LEFT SIDE
-				if (xNew > Net_X) {
-					if (yNew <= Net_H) {
-						// Bounce off of net
-						VxNew   *= -0.5;
-						VyNew   *= 0.5;
-						xNew     = (float) Net_X - 1;
-						nDeadBall = nRule_DeadBall;
-					}
-				}
-			}
-
-            /* Button presses */
-            // LEFT
-			if (nSide == 0 && xOld < Net_X - 7) {
-				if (L_used == 0 && nDeadBall == 0) {
-                    if (nMode > 0 && L_Btn == 0) {
-						VxNew   =     force * getCustomCos(L_angle);
-						VyNew   = g + force * getCustomSin(L_angle);
-						L_used  = nRule_SingleHit;
-						nBallHits = 0;
-                    }
-                    else if(nMode_Auto_L == 1){
-                        if (xOld < 20 || (yOld < L_AUTO_Y && xOld < L_AUTO_X)){
-                            iVal = rand();
-                            j = (unsigned char) iVal >> 8;
-                            
-                            if (j < 10){
-                                // we have 4% chances that the automata will fuck it up totally
-                                L_used = 1;
-                                nDeadBall = 1;
-                            }
-                            else if (j > 50){
-                                // We have 30% (50 / 255) chance that automata will not reply in this iteration
-                                // but we are not making it deadball, it should let the ball continue
-                                // and hit it the next time possibly
-                                
-                                j = ((unsigned char) (iVal & 31) + Angle_Delta + Angle_Min);
-
-                                VxNew   =     force * getCustomCos(j);
-                                VyNew   = g + force * getCustomSin(j);
-                                L_used  = nRule_SingleHit;
-                                nBallHits = 0;
-                            }
-                        }
-                    }
-                }
-			}
-			// RIGHT
-			else if (nSide == 1 && xOld > Net_X + 7) {
-                if (R_used == 0 && nDeadBall == 0) {
-                    if (nMode > 0 && R_Btn == 0) {
-						VxNew   =   - force * getCustomCos(R_angle);
-						VyNew   = g + force * getCustomSin(R_angle);
-						R_used  = nRule_SingleHit;
-						nBallHits = 0;
-                    }
-                    else if (nMode_Auto_R == 1){
-                        if (xOld > 235 || (yOld < R_AUTO_Y && xOld > R_AUTO_X)){
-                            iVal = rand();
-                            j = (unsigned char) iVal >> 8;
-                            
-                            if (j < 10){
-                                // we have 4% chances that the automata will fuck it up totally
-                                R_used = 1;
-                                nDeadBall = 1;
-                            }
-                            else if (j > 50){
-                                // We have 30% (50 / 255) chance that automata will not reply in this iteration
-                                // but we are not making it deadball, it should let the ball continue
-                                // and hit it the next time possibly
-
-                                j = ((unsigned char) (iVal & 31) + Angle_Delta + Angle_Min);
-
-                                VxNew   =   - force * getCustomCos(j);
-                                VyNew   = g + force * getCustomSin(j);
-                                R_used  = nRule_SingleHit;
-                                nBallHits = 0;
-                            }
-                        }
-                    }
-                }
-			}
-		}
+#else
 
-		//Figure out which point we're going to draw.
-		xp =  (int) floor(xNew);
-		yp =  (int) floor(yNew);
-
-        // Draw ball trail
-		m = 0;
-		while (m < Ball_Trail) {
-			k = 0;
-            y = y_Trail[m];
-            x = x_Trail[m];
-			//while (k < (4 * m * m)) {
-            while (k < 10) {
-				V_Write = y;
-				H_Write = x;
-				k++;
-			}
-			m++;
-		}
-        
-        // Draw the ball
-		m = 0;
-		while (m < Ball_Repeat){
-            V_Write = yp;
-            H_Write = xp;
-			m++;
-		}
+void PHYS_step(void){
+    // x' = x + v*t + at*t/2
+    // v' = v + a*t
+    //
+    // Horizontal (X) axis: No acceleration; a = 0.
+    // Vertical   (Y) axis: a = -g
+    xNew  = xOld + VxOld;
+    yNew  = yOld + VyOld - Scene.GravHalf;
 
-        
-        // Shift the values in the stack
-		m = 0;
-		while (m < (Ball_Trail - 1)){
-			x_Trail[m] = x_Trail[m+1];
-			y_Trail[m] = y_Trail[m+1];
-			m++;
-		}
-        // Push the current point to the stack
-		x_Trail[(Ball_Trail - 1)] = xp;
-		y_Trail[(Ball_Trail - 1)] = yp;
+    VyNew = VyOld - Scene.GravStep;
+    VxNew = VxOld;
 
-        
-		//Draw Ground and Net
-		for (k = Net_Repeat; k > 0; k--) {
-           XY_drawGround();
-		}
-        
-        //DEBUG LINES
-        if (nDebug){
-            x = 0;
-            y = 235;
-
-            DEBUG_drawDigit(x, y, nMode);
-            x += 6;
-            DEBUG_drawDigit(x, y, nMode_Auto_L);
-            x += 6;
-            DEBUG_drawDigit(x, y, nMode_Auto_R);
-            x += 8;
-            DEBUG_drawDigit(x, y, nRule_SingleHit);
-            x += 6;
-            DEBUG_drawDigit(x, y, nRule_DeadBall);
-            x += 6;
-            DEBUG_drawChar(x, y, nBallCount);
-            x += 6;
-            DEBUG_drawDigit(x, y, nSide);
-            x += 6;
-            DEBUG_drawDigit(x, y, nDeadBall);
-            x += 6;
-            DEBUG_drawChar(x, y, nBallHits);
-            x += 10;
-            DEBUG_drawChar(x, y, xNew);
-            x += 10;
-            DEBUG_drawChar(x, y, yNew);
+    PHYS_contact();
+}
 
+#endif
 
-            x  = 0;
-            y -= 25;
-            DEBUG_drawChar(x, y, (unsigned char) (iTimerIdle >> 8));
-            DEBUG_drawChar(x, y, (unsigned char) (iTimerIdle & 0x0f));
-            x += 20;
-            DEBUG_drawChar(x, y, (unsigned char) (iDelayNewBall >> 8));
-            DEBUG_drawChar(x, y, (unsigned char) (iDelayNewBall & 0x0f));
+/**
+ * Walls, net, floor and ceiling for the step from Old to New
+ */
+void PHYS_contact(void){
+    long x0, y0, x1, y1;
+    unsigned int t, tHit;
+    unsigned char nHit;
+
+    /* Swept collisions against the walls and the net */
+    // The segment from Old to New is tested in 24.8 fixed point and the
+    // first contact found along it wins, so a fast ball can't go through
+    // the corner of the net between two steps.
+    x0 = (long) (xOld * 256);
+    y0 = (long) (yOld * 256);
+    x1 = (long) (xNew * 256);
+    y1 = (long) (yNew * 256);
+    tHit = PHYS_NoHit;
+    nHit = PHYS_None;
+
+    // Left Wall
+    if (x1 < 0) {
+        tHit = PHYS_cross(x0, x1, 0);
+        nHit = PHYS_WallL;
+    }
+    // Right Wall
+    if (x1 > 255L * 256) {
+        tHit = PHYS_cross(x0, x1, 255L * 256);
+        nHit = PHYS_WallR;
+    }
+    // Net, only from the side the ball is on and under its top at the crossing
+    if (nSide) {
+        // RIGHT SIDE
+        if (x1 < Scene.NetX8) {
+            t = PHYS_cross(x0, x1, Scene.NetX8);
+            if (t < tHit && PHYS_lerp(y0, y1, t) <= Scene.NetH8) {
+                tHit = t;
+                nHit = PHYS_NetR;
+            }
+        }
+    }
+    else {
+        // LEFT SIDE
+        if (x1 > Scene.NetX8) {
+            t = PHYS_cross(x0, x1, Scene.NetX8);
+            if (t < tHit && PHYS_lerp(y0, y1, t) <= Scene.NetH8) {
+                tHit = t;
+                nHit = PHYS_NetL;
+            }
+        }
+    }
 
+    if (nHit != PHYS_None) {
+        // Stop at the contact point, the rest of the step is dropped
+        y1 = PHYS_lerp(y0, y1, tHit);
+        yNew = (float) y1 / 256;
 
-            x  = 0;
-            y -= 25;
-            DEBUG_drawDigit(x, y, L_used);
-            x += 10;
-            DEBUG_drawDigit(x, y, L_Btn);
-            x += 10;
-            DEBUG_drawChar(x, y, L_angle);
+        if (nHit == PHYS_WallL || nHit == PHYS_WallR) {
+            VxNew   *= -0.25;
+            VyNew   *= 0.75;
+            xNew     = (nHit == PHYS_WallL) ? (float) 0 : (float) 255;
+        }
+        else {
+            // Bounce off of net
+            VxNew   *= -0.5;
+            VyNew   *= 0.5;
+            xNew     = (nHit == PHYS_NetR) ? Scene.NetX + 1 : Scene.NetX - 1;
+        }
+        nDeadBall = nRule_DeadBall;
+    }
 
-            x = 127;
-            DEBUG_drawDigit(x, y, R_used);
-            x += 10;
-            DEBUG_drawDigit(x, y, R_Btn);
-            x += 10;
-            DEBUG_drawChar(x, y, R_angle);
+    // Floor
+    // Horizontal speed is not changed by the floor, so X at the end of the
+    // step is already exact and only Y needs to be put back on the floor
+    if (yNew <= 0) {
+        yNew = (float) 0;
+        if (VyNew * VyNew < 10) {
+            nBallHits++;
         }
-        
-        x = 0;
-        y = Net_X;
-        V_Write = 0;
-        H_Write = Net_X;
-        
-        /*
-        y = 190;
-        x = 0;
-        V_Write = y;
-        H_Write = x;
-        DEBUG_line_V(64);
-        V_Write = (nSide > 0) ? y + 50 : y;
-        DEBUG_line_H(20);
-        DEBUG_line_V(64);
-        V_Write = (nDeadBall > 0) ? y + 50 : y;
-        DEBUG_line_H(20);
-        DEBUG_line_V(64);
-        V_Write = y + (unsigned char) nBallHits / 25;
-        DEBUG_line_H(20);
-        DEBUG_line_V(64);
-        V_Write = y + (unsigned char) (iDelayNewBall >> 16) / 25;
-        DEBUG_line_H(30);
-        DEBUG_line_V(64);
-        V_Write = y + (unsigned char) (iDelayNewBall % 255) / 25;
-        DEBUG_line_H(30);
-        DEBUG_line_V(64);
-        
-        DEBUG_drawPlayerL(0,   120);
-        DEBUG_drawPlayerR(127, 120);
-        
-        */
+        if (VyNew < 0) {
+            VyNew *= -0.75;
+        }
+    }
+    // Ceiling
+    if (yNew >= 255) {
+        yNew = (float) 255;
+        VyNew *= -0.75;
+    }
+}
 
-		// Get ready for the next iteration
-        // New values become old values
-		VxOld = VxNew;
-		VyOld = VyNew;
-		xOld  = xNew;
-		yOld  = yNew;
+/**
+ * Where along the step (0 = Old, 256 = New) a0 -> a1 crosses c
+ * Only called when it does cross, so a0 != a1
+ */
+unsigned int PHYS_cross(long a0, long a1, long c){
+    return (unsigned int) (((c - a0) << 8) / (a1 - a0));
+}
 
-	}
+/**
+ * Value at fraction t (0..256) between b0 and b1
+ */
+long PHYS_lerp(long b0, long b1, unsigned int t){
+    return b0 + (((b1 - b0) * (long) t) >> 8);
+}
 
+/**
+ * Hit the ball
+ * nDir: 0 = towards the right (LEFT player), 1 = towards the left (RIGHT player)
+ */
+void PHYS_launch(unsigned char nDir, unsigned char angle){
+    VxNew = Scene.Force * getCustomCos(angle);
+    VyNew = Scene.Grav + Scene.Force * getCustomSin(angle);
+    if (nDir){
+        VxNew = -VxNew;
+    }
+    PHYS_restart();
 }
 
 float getCustomSin(unsigned char angle){
@@ -743,7 +1955,7 @@ void ADC_start(unsigned char nChannel) {
 void DEBUG_line_H(unsigned char delta){
     for (j = 0; j < 5; j++){
         for (m = 0; m < delta; m++) {
-            H_Write = (j % 2 == 0) ? x++ : x--;
+            H_Write = H_Code((j % 2 == 0) ? x++ : x--);
         }
     }
 }
@@ -758,36 +1970,24 @@ void DEBUG_line_V(unsigned char delta){
 }
 
 void XY_drawLineY(signed char delta){
-    H_Write = x;
+    H_Write = H_Code(x);
     V_Write = y;
     if (delta > 0){
-        while (delta > 0){
-            V_Write = y++;
-            delta--;
-        }
+        y = DAC_runY(y, delta, 1);
     }
     else{
-        while (delta < 0){
-            V_Write = y--;
-            delta++;
-        }
+        y = DAC_runY(y, -delta, -1);
     }
 }
 
 void XY_drawLineX(signed char delta){
-    H_Write = x;
+    H_Write = H_Code(x);
     V_Write = y;
     if (delta > 0){
-        while (delta > 0){
-            H_Write = x++;
-            delta--;
-        }
+        x = DAC_runX(x, delta, 1);
     }
     else{
-        while (delta < 0){
-            H_Write = x--;
-            delta++;
-        }
+        x = DAC_runX(x, -delta, -1);
     }
 }
 
@@ -799,6 +1999,246 @@ void DEBUG_drawChar(unsigned char xin, unsigned char yin, unsigned char digit){
 }
 
 
+void DEBUG_drawWord(unsigned char xin, unsigned char yin, unsigned int iWord){
+    DEBUG_drawChar(xin, yin, (unsigned char) (iWord >> 8));
+    DEBUG_drawChar(x, y, (unsigned char) (iWord & 0xff));
+}
+
+
+/**
+ * One row of a debug page, 0 when the page has no such row
+ */
+unsigned char DEBUG_overlayRow(unsigned char nPage, unsigned char nRow){
+    unsigned char i;
+#if defined(PROFILE)
+    unsigned char n;
+#endif
+
+    x = 0;
+    y = DEBUG_Top - nRow * DEBUG_RowH;
+#if defined(PROFILE)
+    if (nPage == DEBUG_PageStages){
+        // Stage, min, avg, max (Timer1 ticks), then the frames over budget
+        if (nRow < PROF_Stages){
+            DEBUG_drawDigit(x, y, nRow);
+            DEBUG_drawWord(16, y, PROF_Min[nRow]);
+            DEBUG_drawWord(72, y, PROF_Avg[nRow]);
+            DEBUG_drawWord(128, y, PROF_Max[nRow]);
+            return 1;
+        }
+        if (nRow == PROF_Stages){
+            DEBUG_drawWord(0, y, PROF_Overruns);
+            return 1;
+        }
+        return 0;
+    }
+    if (nPage == DEBUG_PageTasks){
+        // Task, ticks and slices in the last frame, longest slice
+        if (nRow >= TASK_Count){
+            return 0;
+        }
+        DEBUG_drawDigit(x, y, nRow);
+        DEBUG_drawWord(16, y, TASK_Cycles[nRow]);
+        DEBUG_drawChar(72, y, TASK_Slices[nRow]);
+        DEBUG_drawWord(100, y, TASK_SliceMax[nRow]);
+        return 1;
+    }
+    if (nPage == DEBUG_PageLatency){
+        // Input to photon latency per mode: p50, p99, max (ms), without
+        // debug then with it
+        if (nRow >= MODE_Count){
+            return 0;
+        }
+        DEBUG_drawDigit(x, y, nRow);
+        for (i = 0; i < 2; i++){
+            n = nRow * 2 + i;
+            DEBUG_drawChar(16 + i * 96, y, PROF_latPercentile(n, 50));
+            DEBUG_drawChar(44 + i * 96, y, PROF_latPercentile(n, 99));
+            DEBUG_drawChar(72 + i * 96, y, PROF_LatMax[n]);
+        }
+        return 1;
+    }
+#endif
+    if (nPage == DEBUG_PageTune){
+        // Frame time (ms) and frame rate, the byte the menu points at and
+        // its value, then the whole tune
+        if (nRow == 0){
+            DEBUG_drawChar(0, y, nElapsed);
+            DEBUG_drawChar(40, y, nFps[nBalls - 1]);
+            DEBUG_drawDigit(96, y, nTuneSel);
+            DEBUG_drawChar(112, y, ((unsigned char *) &Tune)[nTuneSel]);
+            return 1;
+        }
+        if (nRow > TUNE_Size){
+            return 0;
+        }
+#if defined(BALL_SUBPIXEL)
+        if (nRow - 1 == TUNE_BallRepeat){
+            return 1;
+        }
+#endif
+        DEBUG_drawDigit(x, y, nRow - 1);
+        DEBUG_drawChar(16, y, ((unsigned char *) &Tune)[nRow - 1]);
+        return 1;
+    }
+    if (nRow == 0){
+        DEBUG_drawDigit(x, y, nMode);
+        x += 6;
+        DEBUG_drawDigit(x, y, nMode_Auto_L);
+        x += 6;
+        DEBUG_drawDigit(x, y, nMode_Auto_R);
+        x += 8;
+        DEBUG_drawDigit(x, y, nRule_SingleHit);
+        x += 6;
+        DEBUG_drawDigit(x, y, nRule_DeadBall);
+        x += 6;
+        DEBUG_drawChar(x, y, nBallCount);
+        x += 6;
+        DEBUG_drawDigit(x, y, nSide);
+        x += 6;
+        DEBUG_drawDigit(x, y, nDeadBall);
+        x += 6;
+        DEBUG_drawChar(x, y, nBallHits);
+        x += 10;
+        DEBUG_drawChar(x, y, Ball_x[0]);
+        x += 10;
+        DEBUG_drawChar(x, y, Ball_y[0]);
+    }
+    else if (nRow == 1){
+        DEBUG_drawChar(x, y, (unsigned char) (iTimerIdle >> 8));
+        DEBUG_drawChar(x, y, (unsigned char) (iTimerIdle & 0x0f));
+        x += 20;
+        DEBUG_drawChar(x, y, (unsigned char) (iDelayNewBall >> 8));
+        DEBUG_drawChar(x, y, (unsigned char) (iDelayNewBall & 0x0f));
+        x += 20;
+        DEBUG_drawChar(x, y, (unsigned char) (iLatBoot >> 8));
+        DEBUG_drawChar(x, y, (unsigned char) (iLatBoot & 0xff));
+        x += 20;
+        DEBUG_drawChar(x, y, (unsigned char) (iLatWake >> 8));
+        DEBUG_drawChar(x, y, (unsigned char) (iLatWake & 0xff));
+    }
+    else if (nRow == 2){
+        DEBUG_drawDigit(x, y, L_used);
+        x += 10;
+        DEBUG_drawDigit(x, y, L_Btn);
+        x += 10;
+        DEBUG_drawChar(x, y, L_angle);
+
+        x = 127;
+        DEBUG_drawDigit(x, y, R_used);
+        x += 10;
+        DEBUG_drawDigit(x, y, R_Btn);
+        x += 10;
+        DEBUG_drawChar(x, y, R_angle);
+    }
+    else if (nRow == 3){
+        // Frame rate per ball count
+        DEBUG_drawDigit(x, y, nBalls);
+        x += 10;
+        for (i = 0; i < BALL_Max; i++){
+            DEBUG_drawChar(x, y, nFps[i]);
+            x += 10;
+        }
+    }
+    else{
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Main loop tasks, see task.h
+ * They run between beam segments in the middle of the main loop's own
+ * loops: they must not touch j, k or m, and what has to survive a yield is
+ * kept in globals.
+ */
+
+/**
+ * Knobs: start a conversion, give the CPU back until it is done, read it,
+ * then the other knob. Both are read every frame. 7 bits, the top of the
+ * left aligned result.
+ */
+unsigned char TASK_adc(void){
+    PT_BEGIN(&PtAdc);
+    ADC_start(L_ADC);
+    PT_WAIT_UNTIL(&PtAdc, ADC_Busy == 0);
+    L_Knob = ADC_Result >> 9;
+
+    ADC_start(R_ADC);
+    PT_WAIT_UNTIL(&PtAdc, ADC_Busy == 0);
+    R_Knob = ADC_Result >> 9;
+    PT_END(&PtAdc);
+}
+
+/**
+ * Debug overlay: one row per slice. The page is picked when the frame
+ * starts drawing it, so a ball served halfway doesn't mix two pages.
+ */
+unsigned char TASK_overlay(void){
+    PT_BEGIN(&PtOverlay);
+    if (!nDebug){
+        PT_EXIT(&PtOverlay);
+    }
+#if defined(PROFILE)
+    nOverlayPage = nBallCount & 3;
+#else
+    nOverlayPage = DEBUG_PageGame;
+#endif
+    if (nTune){
+        nOverlayPage = DEBUG_PageTune;
+    }
+    for (nOverlayRow = 0; DEBUG_overlayRow(nOverlayPage, nOverlayRow); nOverlayRow++){
+        PT_YIELD(&PtOverlay);
+    }
+    PT_END(&PtOverlay);
+}
+
+#if defined(TELEMETRY)
+/**
+ * Frame record to the telemetry stream, see telem.h. The game fields, then
+ * the float velocity and the profiler fields in a slice of their own.
+ */
+unsigned char TASK_telem(void){
+    unsigned char i;
+
+    PT_BEGIN(&PtTelem);
+    Telem.x       = xp;
+    Telem.y       = yp;
+    Telem.L_Angle = L_angle;
+    Telem.R_Angle = R_angle;
+    Telem.Flags   = (unsigned char) L_Btn
+                  | ((unsigned char) R_Btn     << 1)
+                  | ((unsigned char) nSide     << 2)
+                  | ((unsigned char) nDeadBall << 3)
+                  | ((unsigned char) nDebug    << 4)
+                  | ((unsigned char) (nMode & 3) << 5);
+    Telem.Hits    = nBallHits;
+    Telem.FrameMs = nElapsed;
+    PT_YIELD(&PtTelem);
+
+    Telem.Vx      = (signed char) (Ball_Vx[0] * 16);
+    Telem.Vy      = (signed char) (Ball_Vy[0] * 16);
+#if defined(PROFILE)
+    // Once per probe
+    Telem.LatMs   = PROF_LatLast;
+    PROF_LatLast  = PROF_LatNone;
+#else
+    Telem.LatMs   = PROF_LatNone;
+#endif
+    for (i = 0; i < PROF_Stages; i++){
+#if defined(PROFILE)
+        iVal = PROF_Last[i] >> 6;
+        Telem.Stage[i] = (iVal > 255) ? 255 : (unsigned char) iVal;
+#else
+        Telem.Stage[i] = 0;
+#endif
+    }
+    TELEM_send();
+    PT_END(&PtTelem);
+}
+#endif
+
+
 void DEBUG_drawDigit(unsigned char xin, unsigned char yin, unsigned char digit){
     signed char wh   = 4;
     signed char w    = 8;
@@ -970,76 +2410,285 @@ void XY_drawLine(unsigned char xs, unsigned char ys, unsigned char xe, unsigned
         if (y != ye){
             y += dy;
         }
-        H_Write = x;
+        H_Write = H_Code(x);
         V_Write = y;
     }
 }
 
 void XY_drawGround(void){
     // AT LEFT
-    y = 0;
-    x = 0;
+    y = Scene.Y0;
+    x = Scene.X0;
     V_Write = y;
-    H_Write = x;
+    H_Write = H_Code(x);
 
     // To right
-    while (x < Net_X) {
-        H_Write = x;
-        x++;
-    }
+    x = DAC_runX(x, Scene.RunL, 1);
 
     // Net base
     V_Write = y;
-    H_Write = x; // X-position of NET
+    H_Write = H_Code(x); // X-position of NET
 
     // Up
-    while (y < Net_H) {
-        V_Write = y;
-        y++;
-    }
+    y = DAC_runY(y, Scene.RunUp, 1);
     // Down
-    while (y > 1) {
-        V_Write = y;
-        y--;
-    }
+    y = DAC_runY(y, Scene.RunUp - 1, -1);
     // Net base
     V_Write = y;
-    H_Write = x;
+    H_Write = H_Code(x);
     // To right up to the end
-    while (x < 255) {
-        H_Write = x;
-        x++;
-    }
+    x = DAC_runX(x, Scene.RunR, 1);
     // AT RIGHT
     V_Write = y;
-    H_Write = x;
+    H_Write = H_Code(x);
     // To left
-    while (x > Net_X) {
-        H_Write = x;
-        x--;
-    }
+    x = DAC_runX(x, Scene.RunR, -1);
     // Net base
     V_Write = y;
-    H_Write = x;
+    H_Write = H_Code(x);
     // Up
-    while (y < Net_H) {
-        V_Write = y;
-        y++;
-    }
+    y = DAC_runY(y, Scene.RunUp - 1, 1);
     // Down
-    while (y > 1) {
-        V_Write = y;
-        y--;
-    }
+    y = DAC_runY(y, Scene.RunUp - 1, -1);
     // Net base
     V_Write = y;
-    H_Write = x;
+    H_Write = H_Code(x);
     // To left up to start
-    while (x > 1) {
-        H_Write = x;
-        x--;
-    }
+    x = DAC_runX(x, Scene.RunL - 1, -1);
     // Starting point
     V_Write = y;
-    H_Write = x;
-}
\ No newline at end of file
+    H_Write = H_Code(x);
+}
+
+/**
+ * Court from EEPROM, or the ROM defaults, then COURT_build()
+ */
+void COURT_load(void){
+    rom unsigned char *pR = (rom unsigned char *) &COURT_Default;
+    unsigned char *pC = (unsigned char *) &Court;
+    unsigned char nSum;
+
+    EE_readBlock(EE_Court + 1, pC, COURT_Size);
+    nSum = COURT_Magic;
+    for (m = 0; m < COURT_Size; m++){
+        nSum += pC[m];
+    }
+    if (EE_read(EE_Court) != COURT_Magic
+        || EE_read(EE_Court + 1 + COURT_Size) != nSum
+        || !COURT_check()){
+        for (m = 0; m < COURT_Size; m++){
+            pC[m] = pR[m];
+        }
+    }
+    COURT_build();
+}
+
+/**
+ * 1 if the court can be played and drawn: serve points on both sides of the
+ * net, hit zones inside the court, net and view big enough for the ground
+ * runs and the view within the DAC range
+ */
+unsigned char COURT_check(void){
+    if (Court.NetX < COURT_Hit + 1 || Court.NetX > 254 - COURT_Hit
+        || Court.BallL >= Court.NetX || Court.BallR <= Court.NetX
+        || Court.NetH < 8 || Court.NetH == 255 || Court.BallH == 255){
+        return 0;
+    }
+    if (Court.ViewW < COURT_ViewMin || Court.ViewH < COURT_ViewMin
+        || Court.ViewX > 255 - Court.ViewW || Court.ViewY > 255 - Court.ViewH){
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Change one COURT byte (nParam is its offset). Returns 0 and leaves the
+ * court alone when the result doesn't pass COURT_check(). The scene is
+ * rebuilt before the next frame.
+ */
+unsigned char COURT_set(unsigned char nParam, unsigned char nValue){
+    unsigned char *pC = (unsigned char *) &Court;
+    unsigned char nOld;
+
+    if (nParam >= COURT_Size){
+        return 0;
+    }
+    nOld = pC[nParam];
+    pC[nParam] = nValue;
+    if (!COURT_check()){
+        pC[nParam] = nOld;
+        return 0;
+    }
+    nCourtDirty = 1;
+    return 1;
+}
+
+/**
+ * Everything the game and XY_drawGround() take from the court, and the
+ * physics from the tune
+ */
+void COURT_build(void){
+    Scene.NetX   = Court.NetX;
+    Scene.HitL   = Court.NetX - COURT_Hit;
+    Scene.HitR   = Court.NetX + COURT_Hit;
+    Scene.AutoL  = Court.AutoWall;
+    Scene.AutoR  = 255 - Court.AutoWall;
+    Scene.AutoLX = (int) Court.NetX - Court.AutoNet;
+    Scene.AutoRX = (int) Court.NetX + Court.AutoNet;
+    Scene.AutoLY = Court.AutoLY;
+    Scene.AutoRY = Court.AutoRY;
+    Scene.BallL  = Court.BallL;
+    Scene.BallR  = Court.BallR;
+    Scene.BallH  = Court.BallH;
+    Scene.NetX8  = (long) Court.NetX << 8;
+    Scene.NetH8  = (long) Court.NetH << 8;
+    Scene.NetX16 = (long) Court.NetX << 16;
+
+    Scene.ScaleX = Court.ViewW + 1;
+    Scene.ScaleY = Court.ViewH + 1;
+
+    // Same path as the constant court: left end, net, right end
+    Scene.X0    = VIEW_x(0);
+    Scene.Y0    = VIEW_y(0);
+    Scene.NetC  = VIEW_x(Court.NetX);
+    Scene.RunL  = Scene.NetC - Scene.X0;
+    Scene.RunR  = VIEW_x(255) - Scene.NetC;
+    Scene.RunUp = VIEW_y(Court.NetH) - Scene.Y0;
+
+    Scene.Grav     = Tune.Gravity / 100.0;
+    Scene.Force    = Tune.Force / 100.0;
+    Scene.GravStep = Scene.Grav * ts;
+    Scene.GravHalf = 0.5 * Scene.Grav * ts * ts;
+#if defined(PHYS_SEGMENT)
+    Scene.SegA     = (long) (Scene.GravStep * 16777216 + 0.5);
+    Scene.SegC     = (long) (Scene.GravHalf * 16777216 + 0.5);
+#endif
+
+#if defined(LINK)
+    // What the peer has to run too: the court but the view, and the
+    // physics of the tune. Rotate and add, as GAME_sum()
+    LINK_Config = Tune.Gravity | ((word) Tune.Force << 8);
+    for (m = 0; m < COURT_GameSize; m++){
+        LINK_Config = ((LINK_Config << 1) | (LINK_Config >> 15)) + ((unsigned char *) &Court)[m];
+    }
+#endif
+
+#if defined(RALLY)
+    // Same game as the recording, and at least one rally
+    Scene.Rally = (RALLY_Data[0] != RALLY_Wrap)
+               && Tune.Gravity == Ball_Gravity && Tune.Force == Ball_Force;
+    for (m = 0; m < RALLY_CourtSize; m++){
+        if (((unsigned char *) &Court)[m] != RALLY_Court[m]){
+            Scene.Rally = 0;
+        }
+    }
+#endif
+
+    nCourtDirty = 0;
+}
+
+/**
+ * Tune from EEPROM, or the ROM defaults. COURT_load() builds the scene
+ * after it
+ */
+void TUNE_load(void){
+    rom unsigned char *pR = (rom unsigned char *) &TUNE_Default;
+    unsigned char *pT = (unsigned char *) &Tune;
+    unsigned char nSum;
+
+    EE_readBlock(EE_Tune + 1, pT, TUNE_Size);
+    nSum = TUNE_Magic;
+    for (m = 0; m < TUNE_Size; m++){
+        nSum += pT[m];
+    }
+    if (EE_read(EE_Tune) != TUNE_Magic
+        || EE_read(EE_Tune + 1 + TUNE_Size) != nSum
+        || !TUNE_check()){
+        for (m = 0; m < TUNE_Size; m++){
+            pT[m] = pR[m];
+        }
+    }
+}
+
+/**
+ * 1 if every TUNE byte is within its TUNE_Min / TUNE_Max
+ */
+unsigned char TUNE_check(void){
+    unsigned char *pT = (unsigned char *) &Tune;
+
+    for (m = 0; m < TUNE_Size; m++){
+        if (pT[m] < TUNE_Min[m] || pT[m] > TUNE_Max[m]){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Change one TUNE byte (nParam is its offset). Returns 0 and leaves it
+ * alone when out of bounds. Takes effect on the next frame, the idle
+ * timeouts on the next button press.
+ */
+unsigned char TUNE_set(unsigned char nParam, unsigned char nValue){
+    if (nParam >= TUNE_Size
+        || nValue < TUNE_Min[nParam] || nValue > TUNE_Max[nParam]){
+        return 0;
+    }
+    // Held, the menu sets the same value every frame
+    if (((unsigned char *) &Tune)[nParam] != nValue){
+        ((unsigned char *) &Tune)[nParam] = nValue;
+        nCourtDirty = 1;
+    }
+    return 1;
+}
+
+/**
+ * Tune to EEPROM. Only the cells that changed are written, about 4 ms each,
+ * the frame they are written in is that much longer.
+ */
+void TUNE_save(void){
+    unsigned char *pT = (unsigned char *) &Tune;
+    unsigned char nSum = TUNE_Magic;
+
+    EE_write(EE_Tune, TUNE_Magic);
+    for (m = 0; m < TUNE_Size; m++){
+        EE_write(EE_Tune + 1 + m, pT[m]);
+        nSum += pT[m];
+    }
+    EE_write(EE_Tune + 1 + TUNE_Size, nSum);
+}
+
+/**
+ * Tuning menu frame, see MODE_frameDebug()
+ * The left knob picks a TUNE byte, the right knob sets it over its bounds
+ * while the right button is down. The left button saves the tune to EEPROM
+ * and restarts the mode. Both buttons are still down from the combination
+ * that opened the menu (with the knobs at 0), each one only counts once it
+ * has been released. The debug overlay shows the tune next to the frame
+ * time.
+ */
+void TUNE_menu(void){
+#if defined(BALL_SUBPIXEL)
+    nTuneSel = (unsigned char) (((unsigned int) L_angle * (TUNE_Size - 1)) >> 7);
+    if (nTuneSel >= TUNE_BallRepeat){
+        nTuneSel++;
+    }
+#else
+    nTuneSel = (unsigned char) (((unsigned int) L_angle * TUNE_Size) >> 7);
+#endif
+    if (R_Btn != 0){
+        nTuneSet = 1;
+    }
+    else if (nTuneSet){
+        iVal = TUNE_Max[nTuneSel] - TUNE_Min[nTuneSel];
+        iVal = TUNE_Min[nTuneSel] + (iVal * R_angle + 63) / 127;
+        TUNE_set(nTuneSel, (unsigned char) iVal);
+    }
+    if (L_Btn != 0){
+        nTuneArm = 1;
+    }
+    else if (nTuneArm){
+        TUNE_save();
+        MODE_enter(nMode);
+    }
+}
@@ -0,0 +1,207 @@
+#include <p18cxxx.h>
+#include "timer.h"
+#include "prof.h"
+
+#if defined(PROFILE)
+
+// Probe states
+#define PROF_LatIdle    0
+#define PROF_LatArmed   1   // Edge set, waiting for a step to sample it
+#define PROF_LatSampled 2   // A step has seen it, the next one moves the ball
+#define PROF_LatMoved   3   // Waiting for the ball to be drawn
+
+#pragma udata
+
+unsigned int  PROF_Min[PROF_Stages];
+unsigned int  PROF_Max[PROF_Stages];
+unsigned int  PROF_Avg[PROF_Stages];
+unsigned int  PROF_Last[PROF_Stages];   // Previous frame
+unsigned int  PROF_Overruns = 0;
+
+unsigned int  PROF_Cur[PROF_Stages];    // This frame
+unsigned long PROF_Sum[PROF_Stages];    // This window
+unsigned int  PROF_Mark   = 0;          // Timer1 at the last mark
+unsigned char PROF_Frames = 0;          // Frames in this window
+
+unsigned char PROF_LatMax[PROF_LatSets];
+unsigned char PROF_LatLast   = PROF_LatNone;
+unsigned char PROF_LatState  = PROF_LatIdle;
+unsigned char PROF_LatFrames = 0;       // Frames since the probe was armed
+unsigned int  PROF_LatEdge   = 0;       // Timer0 at the virtual edge
+unsigned int  PROF_LatFrame  = 0;       // Timer0 at the start of this frame
+unsigned int  PROF_LatLen    = 0;       // Timer0 ticks of the last frame
+unsigned int  PROF_LatRand   = 1;       // Own generator, GAME_rand() belongs to the game
+
+// 128 bytes, own section so the rest of prof.c still fits in one bank
+#pragma udata PROF_LAT
+unsigned char PROF_LatHist[PROF_LatSets][PROF_LatBins];
+
+#pragma code
+
+unsigned int PROF_ticks(void){
+    unsigned int iNow;
+
+    // TMR1H is latched when TMR1L is read (RD16)
+    iNow  = TMR1L;
+    iNow |= (unsigned int) TMR1H << 8;
+    return iNow;
+}
+
+void PROF_init(void){
+    unsigned char i, j;
+
+    for (i = 0; i < PROF_Stages; i++){
+        PROF_Min[i] = 0xffff;
+        PROF_Max[i] = 0;
+        PROF_Avg[i] = 0;
+        PROF_Last[i] = 0;
+        PROF_Cur[i] = 0;
+        PROF_Sum[i] = 0;
+    }
+    PROF_Overruns = 0;
+    PROF_Frames   = 0;
+
+    for (i = 0; i < PROF_LatSets; i++){
+        PROF_LatMax[i] = 0;
+        for (j = 0; j < PROF_LatBins; j++){
+            PROF_LatHist[i][j] = 0;
+        }
+    }
+    PROF_LatLast  = PROF_LatNone;
+    PROF_LatState = PROF_LatIdle;
+    PROF_LatFrame = TIMER_ticks();
+    PROF_LatLen   = 0;
+
+    TMR1H = 0;
+    TMR1L = 0;
+    T1CON = PROF_T1CON;
+    PROF_Mark = PROF_ticks();
+}
+
+void PROF_stage(unsigned char nStage){
+    unsigned int iNow = PROF_ticks();
+
+    PROF_Cur[nStage] += iNow - PROF_Mark;
+    PROF_Mark = iNow;
+}
+
+void PROF_frame(void){
+    unsigned char i;
+    unsigned long lTotal = 0;
+    unsigned int  iNow;
+
+    for (i = 0; i < PROF_Stages; i++){
+        if (PROF_Cur[i] < PROF_Min[i]){
+            PROF_Min[i] = PROF_Cur[i];
+        }
+        if (PROF_Cur[i] > PROF_Max[i]){
+            PROF_Max[i] = PROF_Cur[i];
+        }
+        PROF_Sum[i] += PROF_Cur[i];
+        lTotal      += PROF_Cur[i];
+        PROF_Last[i] = PROF_Cur[i];
+        PROF_Cur[i]  = 0;
+    }
+
+    if (lTotal > PROF_Budget && PROF_Overruns < 0xffff){
+        PROF_Overruns++;
+    }
+
+    PROF_Frames++;
+    if (PROF_Frames >= PROF_Window){
+        for (i = 0; i < PROF_Stages; i++){
+            PROF_Avg[i] = (unsigned int) (PROF_Sum[i] >> PROF_Shift);
+            PROF_Sum[i] = 0;
+        }
+        PROF_Frames = 0;
+    }
+
+    // Latency probe: the next one goes somewhere in the coming frame,
+    // assumed as long as the last one
+    iNow = TIMER_ticks();
+    PROF_LatLen   = iNow - PROF_LatFrame;
+    PROF_LatFrame = iNow;
+    if (PROF_LatState != PROF_LatIdle){
+        PROF_LatFrames++;
+        if (PROF_LatFrames > PROF_LatAge){
+            PROF_LatState = PROF_LatIdle;
+        }
+    }
+    if (PROF_LatState == PROF_LatIdle){
+        // xorshift, 16 bits
+        PROF_LatRand ^= PROF_LatRand << 7;
+        PROF_LatRand ^= PROF_LatRand >> 9;
+        PROF_LatRand ^= PROF_LatRand << 8;
+        PROF_LatEdge   = iNow + (unsigned int) (((unsigned long) PROF_LatRand * PROF_LatLen) >> 16);
+        PROF_LatFrames = 0;
+        PROF_LatState  = PROF_LatArmed;
+    }
+
+    PROF_Mark = PROF_ticks();
+}
+
+void PROF_latStep(void){
+    if (PROF_LatState == PROF_LatArmed){
+        if ((signed int) (TIMER_ticks() - PROF_LatEdge) >= 0){
+            PROF_LatState = PROF_LatSampled;
+        }
+    }
+    else if (PROF_LatState == PROF_LatSampled){
+        PROF_LatState = PROF_LatMoved;
+    }
+}
+
+void PROF_latPhoton(unsigned char nSet){
+    unsigned int  iMs;
+    unsigned char i, nBin;
+
+    if (PROF_LatState != PROF_LatMoved){
+        return;
+    }
+    PROF_LatState = PROF_LatIdle;
+
+    iMs = (TIMER_ticks() - PROF_LatEdge) / TIMER_TicksPerMs;
+    if (iMs > 254){
+        iMs = 254;
+    }
+    PROF_LatLast = (unsigned char) iMs;
+    if (PROF_LatLast > PROF_LatMax[nSet]){
+        PROF_LatMax[nSet] = PROF_LatLast;
+    }
+
+    nBin = PROF_LatLast / PROF_LatBin;
+    if (nBin >= PROF_LatBins){
+        nBin = PROF_LatBins - 1;
+    }
+    // Byte counters: halve the set when one is full, the shape stays
+    if (PROF_LatHist[nSet][nBin] == 255){
+        for (i = 0; i < PROF_LatBins; i++){
+            PROF_LatHist[nSet][i] >>= 1;
+        }
+    }
+    PROF_LatHist[nSet][nBin]++;
+}
+
+unsigned char PROF_latPercentile(unsigned char nSet, unsigned char nPct){
+    unsigned int  iTotal = 0;
+    unsigned int  iSum   = 0;
+    unsigned char i;
+
+    for (i = 0; i < PROF_LatBins; i++){
+        iTotal += PROF_LatHist[nSet][i];
+    }
+    if (iTotal == 0){
+        return 0;
+    }
+    // Smallest bin with at least nPct % of the probes at or below it
+    iTotal = (unsigned int) (((unsigned long) iTotal * nPct + 99) / 100);
+    for (i = 0; i < PROF_LatBins - 1; i++){
+        iSum += PROF_LatHist[nSet][i];
+        if (iSum >= iTotal){
+            break;
+        }
+    }
+    return (unsigned char) ((i + 1) * PROF_LatBin);
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * File:   prof.h
+ *
+ * Main loop profiler
+ * Timer1 counts instruction cycles (Fosc/4) through PROF_Prescale, so one
+ * tick is 1 us at 4 MHz and 0.8 us at 40 MHz, and a 16 bit count covers a
+ * whole 20 ms frame at either clock. PROF_stage(n) charges the ticks since
+ * the previous mark to stage n, PROF_frame() closes the frame: per stage
+ * min / max / average over PROF_Window frames, plus the number of frames
+ * over PROF_Budget ticks.
+ *
+ * Input to photon latency: each frame a virtual button edge is placed at a
+ * random time within the next frame. The edge is seen by the first game step
+ * that samples the buttons after it, the step after that one moves the ball
+ * on the new trajectory, and the photon is the first sample of the ball
+ * drawn there (the trail ends on it). Edge to photon goes to one histogram
+ * per mode and debug state. Only timing is measured, the game never sees
+ * the virtual edge.
+ *
+ * Only built with PROFILE defined, otherwise every call is an empty macro.
+ */
+
+#ifndef PROF_H
+#define	PROF_H
+
+// Stages, in main loop order
+#define PROF_Mode    0  // Mode, debug toggle and idle timers
+#define PROF_Adc     1  // Knob task slices
+#define PROF_Phys    2  // Game step and physics
+#define PROF_Hit     3  // Hits and autoplayers
+#define PROF_Trail   4  // Trail draw
+#define PROF_Ball    5  // Ball draw
+#define PROF_Ground  6  // XY_drawGround()
+#define PROF_Debug   7  // Overlay and telemetry task slices
+#define PROF_Stages  8
+
+// Frames averaged, power of 2
+#define PROF_Window  64
+#define PROF_Shift   6
+
+#if defined(CLOCK_HSPLL)
+#define PROF_T1CON     0b10110001  // RD16, 1:8, Fosc/4, ON -> 52 ms to wrap
+#define PROF_Prescale  8
+#else
+#define PROF_T1CON     0b10000001  // RD16, 1:1, Fosc/4, ON -> 65 ms to wrap
+#define PROF_Prescale  1
+#endif
+
+// Frame budget, ticks (default 20 ms)
+#ifndef PROF_Budget
+#define PROF_Budget  ((unsigned long) FOSC / 4 / PROF_Prescale / 50)
+#endif
+
+// Latency histograms, one per mode and debug state: nMode * 2 + nDebug
+#define PROF_LatSets 8
+#define PROF_LatBins 16
+#define PROF_LatBin  4  // ms per bin
+#define PROF_LatAge  8  // Frames before a probe is dropped (stalled steps, sleep)
+#define PROF_LatNone 255
+
+#if defined(PROFILE)
+
+extern unsigned int  PROF_Min[PROF_Stages];
+extern unsigned int  PROF_Max[PROF_Stages];
+extern unsigned int  PROF_Avg[PROF_Stages];
+extern unsigned int  PROF_Last[PROF_Stages];
+extern unsigned int  PROF_Overruns;
+extern unsigned char PROF_LatHist[PROF_LatSets][PROF_LatBins];
+extern unsigned char PROF_LatMax[PROF_LatSets];  // ms
+extern unsigned char PROF_LatLast;               // ms, PROF_LatNone until a probe ends
+
+void PROF_init(void);
+void PROF_stage(unsigned char nStage);
+void PROF_frame(void);
+
+/**
+ * Timer1, PROF_Prescale instruction cycles per tick
+ */
+unsigned int PROF_ticks(void);
+
+/**
+ * Latency probe: at the start of every game step, where the buttons are
+ * sampled
+ */
+void PROF_latStep(void);
+
+/**
+ * Latency probe: right before ball 0 is drawn, nSet = nMode * 2 + nDebug
+ */
+void PROF_latPhoton(unsigned char nSet);
+
+/**
+ * Latency (ms, upper edge of the bin) at nPct percent of the probes of nSet
+ */
+unsigned char PROF_latPercentile(unsigned char nSet, unsigned char nPct);
+
+#else
+
+#define PROF_init()
+#define PROF_stage(n)
+#define PROF_frame()
+#define PROF_latStep()
+#define PROF_latPhoton(n)
+
+#endif
+
+#endif	/* PROF_H */
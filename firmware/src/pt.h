@@ -0,0 +1,72 @@
+/*
+ * File:   pt.h
+ *
+ * Protothreads
+ * Stackless coroutines after Adam Dunkels' protothreads: a task is a plain
+ * function that returns at each yield and, called again, carries on from
+ * there through a switch on the line it left at. Nothing is kept but that
+ * line number, 2 bytes per task. The PIC18 return stack is 31 deep and
+ * C18's software stack is shared by everyone, so a task can't have a stack
+ * of its own.
+ *
+ * The catch: locals don't survive a yield (keep what must in statics or
+ * globals), and a task can't yield from inside a switch of its own or from
+ * a function it calls.
+ *
+ *   unsigned char TASK_foo(void){
+ *       static PT pt;
+ *       PT_BEGIN(&pt);
+ *       ...
+ *       PT_YIELD(&pt);
+ *       ...
+ *       PT_WAIT_UNTIL(&pt, ADC_Busy == 0);
+ *       ...
+ *       PT_END(&pt);
+ *   }
+ */
+
+#ifndef PT_H
+#define	PT_H
+
+// What a task returns
+#define PT_Waiting   0        // Blocked on PT_WAIT_UNTIL()
+#define PT_Yielded   1        // Gave the CPU back, more to do
+#define PT_Ended     2        // Done, the next call starts over
+
+typedef struct _PT
+{
+    unsigned int lc;          // Line to resume at, 0: the top
+} PT;
+
+#define PT_INIT(pt)           (pt)->lc = 0
+
+#define PT_BEGIN(pt)          switch ((pt)->lc) { case 0:
+
+#define PT_END(pt)            } (pt)->lc = 0; return PT_Ended
+
+#define PT_YIELD(pt)                            \
+    do {                                        \
+        (pt)->lc = __LINE__;                    \
+        return PT_Yielded;                      \
+        case __LINE__:;                         \
+    } while (0)
+
+// The case sits in an if (0) so the first pass doesn't fall into it
+#define PT_WAIT_UNTIL(pt, cond)                 \
+    do {                                        \
+        (pt)->lc = __LINE__;                    \
+        if (0){                                 \
+        case __LINE__:;                         \
+        }                                       \
+        if (!(cond)){                           \
+            return PT_Waiting;                  \
+        }                                       \
+    } while (0)
+
+#define PT_EXIT(pt)                             \
+    do {                                        \
+        (pt)->lc = 0;                           \
+        return PT_Ended;                        \
+    } while (0)
+
+#endif	/* PT_H */
@@ -0,0 +1,360 @@
+/*
+ * Attract mode rallies, see rally.h
+ * Generated by tools/rallygen.c, do not edit:
+ *   rallygen -b 4096 -n 500000 -s 1 -c 6 -t 150
+ * 5 rallies of 66 recorded, 21848 steps (436 s), 4006 bytes
+ */
+
+#include "rally.h"
+
+#if defined(RALLY)
+
+rom unsigned char RALLY_Court[RALLY_CourtSize] = {
+    127, 61, 25, 230, 110, 20, 20, 50, 55,
+};
+
+rom unsigned char RALLY_Data[] = {
+    // Step 39786: 19 crossings, 4249 steps
+    0x01, 0x19, 0x6e, 0x02, 0x64, 0x03, 0x4d, 0x19, 0x00, 0x6d, 0xff, 0x00,
+    0x00, 0xff, 0xfc, 0x03, 0x0c, 0x19, 0x00, 0x3d, 0xf0, 0x00, 0x00, 0xfe,
+    0xc1, 0x03, 0x36, 0x1a, 0x3e, 0x30, 0xc4, 0x00, 0xfa, 0x01, 0xcd, 0x03,
+    0x4f, 0x50, 0x57, 0x7a, 0xb9, 0x01, 0x01, 0x00, 0xee, 0x03, 0x4e, 0x9f,
+    0x83, 0x92, 0xd9, 0x01, 0x01, 0xff, 0xaa, 0x03, 0x3c, 0xeb, 0x9d, 0x4b,
+    0xf7, 0xfe, 0xed, 0x01, 0xaf, 0x03, 0x4e, 0xa9, 0xf6, 0x94, 0xf6, 0xfe,
+    0xe8, 0x00, 0xbb, 0x03, 0x3e, 0x54, 0x96, 0x9d, 0xc1, 0xfe, 0xe8, 0xff,
+    0x7b, 0x03, 0x15, 0x12, 0xa9, 0x62, 0xb7, 0x00, 0xdf, 0x01, 0xe5, 0x03,
+    0x46, 0x26, 0x10, 0x86, 0x90, 0x00, 0xed, 0x01, 0x88, 0x03, 0x4e, 0x66,
+    0xe8, 0xca, 0xfd, 0x00, 0xed, 0x00, 0x69, 0x03, 0x43, 0xaf, 0x2a, 0xba,
+    0xe2, 0x00, 0xed, 0xff, 0x29, 0x03, 0x06, 0xeb, 0x47, 0x62, 0xfa, 0xfe,
+    0xf3, 0x01, 0xba, 0x03, 0x50, 0xe3, 0xff, 0x6b, 0xbd, 0xfe, 0xc1, 0x01,
+    0x5c, 0x03, 0x4e, 0x80, 0x55, 0xa5, 0xdc, 0xfe, 0xc1, 0x00, 0x14, 0x03,
+    0x0d, 0x1f, 0x28, 0x7b, 0xf0, 0xfe, 0xc1, 0xfe, 0xd5, 0x03, 0x4e, 0x11,
+    0x80, 0x6e, 0x31, 0x01, 0x4a, 0x01, 0x58, 0x03, 0x47, 0x76, 0x20, 0xa6,
+    0xf3, 0x01, 0x4a, 0x00, 0x19, 0x03, 0x16, 0xd1, 0xb8, 0x85, 0xfb, 0x01,
+    0x4a, 0xfe, 0xf6, 0x03, 0x06, 0xeb, 0xc9, 0x6e, 0x87, 0xfe, 0xbd, 0x01,
+    0x68, 0x03, 0x48, 0xe5, 0x83, 0x78, 0xa9, 0xfe, 0xff, 0x01, 0xb3, 0x03,
+    0x4c, 0x9d, 0x5a, 0xc9, 0xfa, 0xfe, 0xff, 0x00, 0x8c, 0x03, 0x41, 0x51,
+    0x2f, 0xc5, 0xd3, 0xfe, 0xff, 0xff, 0x54, 0x03, 0x09, 0x11, 0xb6, 0x7c,
+    0xad, 0x00, 0xab, 0x02, 0x03, 0x03, 0x4b, 0x19, 0xae, 0x8d, 0x23, 0x00,
+    0xe6, 0x01, 0xc7, 0x03, 0x49, 0x5d, 0x2c, 0xe5, 0xf6, 0x00, 0xe6, 0x00,
+    0x94, 0x03, 0x4a, 0x9e, 0xde, 0xe5, 0xfc, 0x00, 0xe6, 0xff, 0x69, 0x03,
+    0x0d, 0xe1, 0x75, 0x8e, 0xfb, 0x00, 0xe6, 0xfe, 0x39, 0x03, 0x55, 0xeb,
+    0x1f, 0x7a, 0x3c, 0xff, 0x28, 0x01, 0xea, 0x03, 0x54, 0xa3, 0x45, 0xe3,
+    0xf6, 0xff, 0x28, 0x00, 0x8e, 0x03, 0x54, 0x5c, 0x43, 0xda, 0xe0, 0xff,
+    0x28, 0xff, 0x36, 0x03, 0x04, 0x15, 0x41, 0x60, 0xe4, 0xff, 0x28, 0xfd,
+    0xde, 0x03, 0x04, 0x13, 0xc4, 0x5c, 0x2d, 0x00, 0xab, 0x02, 0x08, 0x03,
+    0x51, 0x18, 0x05, 0x62, 0xbf, 0x01, 0x32, 0x01, 0x7b, 0x03, 0x53, 0x78,
+    0xc9, 0xa6, 0xef, 0x01, 0x32, 0x00, 0x30, 0x03, 0x0f, 0xdb, 0xf0, 0x7f,
+    0xea, 0x01, 0x32, 0xfe, 0xdc, 0x03, 0x06, 0xeb, 0x63, 0x6f, 0xd8, 0xfe,
+    0xce, 0x01, 0x88, 0x03, 0x4a, 0xe5, 0xb1, 0x7a, 0x93, 0xff, 0x1a, 0x01,
+    0xcb, 0x03, 0x52, 0xa3, 0x19, 0xd3, 0xfd, 0xff, 0x1a, 0x00, 0x9c, 0x03,
+    0x4f, 0x59, 0x4e, 0xd0, 0xbc, 0xff, 0x1a, 0xff, 0x4c, 0x03, 0x1d, 0x12,
+    0x37, 0x67, 0xd9, 0x01, 0x18, 0x01, 0xac, 0x03, 0x58, 0x31, 0x56, 0x93,
+    0x10, 0x01, 0x13, 0x01, 0x40, 0x03, 0x50, 0x8f, 0xb7, 0xc3, 0xf8, 0x01,
+    0x13, 0xff, 0xd8, 0x03, 0x08, 0xe5, 0x83, 0x84, 0xe9, 0x01, 0x13, 0xfe,
+    0x90, 0x03, 0x04, 0xec, 0x71, 0x7c, 0x99, 0xff, 0x6d, 0x02, 0x0f, 0x03,
+    0x53, 0xe8, 0x30, 0x83, 0x0b, 0xfe, 0xce, 0x01, 0x7f, 0x03, 0x50, 0x85,
+    0x09, 0xc8, 0xeb, 0xfe, 0xce, 0x00, 0x2c, 0x03, 0x11, 0x25, 0x77, 0xa3,
+    0xf2, 0xfe, 0xce, 0xfe, 0xe4, 0x03, 0x05, 0x13, 0x78, 0x91, 0xe9, 0x01,
+    0x23, 0x01, 0x9e, 0x03, 0x4b, 0x18, 0x19, 0x9b, 0x02, 0x00, 0xdf, 0x01,
+    0xd5, 0x03, 0x10, 0x59, 0x90, 0xf7, 0xe3, 0x00, 0xdf, 0x00, 0xa1, 0x03,
+    0x50, 0x67, 0x88, 0xfe, 0x5f, 0x00, 0xdf, 0xff, 0xaa, 0x03, 0x3d, 0xad,
+    0x5c, 0xb0, 0xd9, 0x00, 0xdf, 0xfe, 0x62, 0x03, 0x04, 0xe0, 0xb5, 0x35,
+    0x41, 0xff, 0x3e, 0x01, 0xfa, 0x03, 0x51, 0xdc, 0x42, 0x3b, 0x97, 0xfe,
+    0xc5, 0x01, 0x6c, 0x03, 0x53, 0x78, 0xab, 0x7a, 0xe2, 0xfe, 0xc5, 0x00,
+    0x20, 0x03, 0x05, 0x12, 0x9f, 0x4e, 0xd8, 0x01, 0x18, 0x01, 0xac, 0x03,
+    0x51, 0x16, 0x64, 0x58, 0x89, 0x00, 0xab, 0x01, 0xf7, 0x03, 0x56, 0x4c,
+    0xa0, 0xc3, 0xe4, 0x00, 0xab, 0x00, 0xab, 0x03, 0x50, 0x86, 0x35, 0xc2,
+    0xf9, 0x00, 0xab, 0xff, 0x4b, 0x03, 0x12, 0xbb, 0xc6, 0x57, 0xe2, 0x00,
+    0xab, 0xfe, 0x03, 0x03, 0x07, 0xc5, 0xf1, 0x35, 0x6f, 0xff, 0x55, 0x02,
+    0x08, 0x03, 0x4c, 0xbf, 0x1e, 0x41, 0xbc, 0xfe, 0xf9, 0x01, 0xa8, 0x03,
+    0x4c, 0x71, 0x1e, 0x91, 0xff, 0xfe, 0xf9, 0x00, 0x71, 0x03, 0x11, 0x23,
+    0x1f, 0x85, 0xd8, 0xfe, 0xf9, 0xff, 0x39, 0x03, 0x87, 0x13, 0xe1, 0x79,
+    0x12, 0x01, 0x3b, 0x01, 0x78, 0x03, 0x2a, 0xb9, 0xdc, 0xb0, 0xdd, 0x01,
+    0x3b, 0xff, 0x53, 0x03, 0x07, 0xeb, 0x45, 0x89, 0xdd, 0xfe, 0xb6, 0x01,
+    0x58, 0x03, 0x4c, 0xe2, 0xec, 0x94, 0x52, 0xfe, 0xd3, 0x01, 0x77, 0x03,
+    0x54, 0x89, 0x8b, 0xd5, 0xf1, 0xfe, 0xd3, 0x00, 0x3f, 0x03, 0x12, 0x26,
+    0xc2, 0xb2, 0xf3, 0xfe, 0xd3, 0xfe, 0xe7, 0x03, 0x3d, 0x13, 0x77, 0xa0,
+    0x24, 0x00, 0xa4, 0x02, 0x0c, 0x03, 0x53, 0x3a, 0x6c, 0xff, 0x00, 0x00,
+    0xa4, 0xff, 0x33, 0x03, 0x35, 0x6f, 0x6f, 0x85, 0xf1, 0x00, 0xa4, 0xfd,
+    0xdf, 0x03, 0x53, 0x91, 0x49, 0x00, 0x00, 0x00, 0xa4, 0x02, 0x3c, 0x03,
+    0x27, 0xc6, 0x4c, 0x82, 0xf1, 0x00, 0xa4, 0x00, 0xe8,
+    // Step 256681: 28 crossings, 6090 steps
+    0x01, 0xe6, 0x6e, 0x02, 0x64, 0x03, 0x4d, 0xe6, 0x00, 0x6d, 0xff, 0x00,
+    0x00, 0xff, 0xfc, 0x03, 0x08, 0xe6, 0x00, 0x3d, 0xf0, 0x00, 0x00, 0xfe,
+    0xc1, 0x03, 0x08, 0xe5, 0x27, 0x36, 0xc8, 0xff, 0x28, 0x01, 0xe6, 0x03,
+    0x51, 0xe0, 0x0e, 0x46, 0xc6, 0xff, 0x64, 0x01, 0xf3, 0x03, 0x51, 0xae,
+    0xda, 0xb0, 0xd1, 0xff, 0x64, 0x00, 0xa7, 0x03, 0x51, 0x7d, 0xa7, 0xb1,
+    0xe3, 0xff, 0x64, 0xff, 0x5b, 0x03, 0x0e, 0x4c, 0x73, 0x49, 0xfb, 0xff,
+    0x64, 0xfe, 0x10, 0x03, 0x0c, 0x45, 0x50, 0x31, 0x81, 0x01, 0x2d, 0x01,
+    0x8f, 0x03, 0x57, 0x54, 0x5d, 0x41, 0xaa, 0x01, 0x43, 0x01, 0x3b, 0x03,
+    0x23, 0xc2, 0x19, 0x70, 0xee, 0x01, 0x43, 0xff, 0xd7, 0x03, 0x49, 0xeb,
+    0xca, 0x64, 0x04, 0xfe, 0xd8, 0x01, 0x97, 0x03, 0x4f, 0x97, 0x59, 0xad,
+    0xee, 0xfe, 0xd8, 0x00, 0x6c, 0x03, 0x25, 0x3b, 0xf8, 0x9d, 0xda, 0xfe,
+    0xd8, 0xff, 0x28, 0x03, 0x09, 0x13, 0x7b, 0x76, 0xff, 0x01, 0x28, 0x01,
+    0x93, 0x03, 0x4c, 0x1c, 0xd9, 0x86, 0x23, 0x01, 0x07, 0x01, 0xa0, 0x03,
+    0x4a, 0x6a, 0xd8, 0xd3, 0xf7, 0x01, 0x07, 0x00, 0x69, 0x03, 0x36, 0xb6,
+    0xca, 0xc6, 0xf3, 0x01, 0x07, 0xff, 0x39, 0x03, 0x08, 0xec, 0x16, 0x89,
+    0x73, 0xff, 0x64, 0x02, 0x10, 0x03, 0x52, 0xe5, 0xff, 0x98, 0xfa, 0xff,
+    0x3e, 0x01, 0xe1, 0x03, 0x04, 0xa7, 0xb6, 0xfd, 0xfe, 0xff, 0x3e, 0x00,
+    0x91, 0x03, 0x4d, 0xa4, 0xac, 0xfe, 0x2d, 0xff, 0x3e, 0xff, 0x91, 0x03,
+    0x3d, 0x6a, 0x30, 0xad, 0xee, 0xff, 0x3e, 0xfe, 0x55, 0x03, 0x0b, 0x3d,
+    0x5f, 0x2f, 0x9d, 0x00, 0xb3, 0x02, 0x03, 0x03, 0x53, 0x43, 0xde, 0x45,
+    0xbc, 0x00, 0x8b, 0x01, 0xf2, 0x03, 0x4e, 0x71, 0x01, 0xb0, 0xcc, 0x00,
+    0x8b, 0x00, 0x9e, 0x03, 0x4f, 0x9b, 0x6b, 0xb0, 0xf2, 0x00, 0x8b, 0xff,
+    0x5f, 0x03, 0x0e, 0xc6, 0x61, 0x4d, 0xdf, 0x00, 0x8b, 0xfe, 0x1b, 0x03,
+    0x07, 0xcc, 0x8d, 0x35, 0xdf, 0xff, 0x1a, 0x01, 0xdb, 0x03, 0x50, 0xc8,
+    0x32, 0x43, 0xf2, 0xff, 0x6d, 0x01, 0xfb, 0x03, 0x54, 0x9a, 0x22, 0xaf,
+    0xc8, 0xff, 0x6d, 0x00, 0xb3, 0x03, 0x52, 0x69, 0xc3, 0xb2, 0xcd, 0xff,
+    0x6d, 0xff, 0x5b, 0x03, 0x0e, 0x3a, 0x8c, 0x48, 0xda, 0xff, 0x6d, 0xfe,
+    0x0b, 0x03, 0x0c, 0x33, 0xfd, 0x30, 0x06, 0x00, 0xed, 0x01, 0xd5, 0x03,
+    0x50, 0x3e, 0x23, 0x46, 0x3b, 0x00, 0xd1, 0x01, 0xc7, 0x03, 0x50, 0x7f,
+    0x84, 0xa1, 0xcb, 0x00, 0xd1, 0x00, 0x7f, 0x03, 0x36, 0xc0, 0xe5, 0x96,
+    0xf6, 0x00, 0xd1, 0xff, 0x37, 0x03, 0x53, 0xea, 0xf7, 0x58, 0xd4, 0xfe,
+    0xd3, 0x01, 0x8f, 0x03, 0x58, 0x89, 0x5a, 0xa3, 0xcf, 0xfe, 0xd3, 0x00,
+    0x3b, 0x03, 0x0e, 0x21, 0xdc, 0x7a, 0xed, 0xfe, 0xd3, 0xfe, 0xd3, 0x03,
+    0x09, 0x13, 0x4d, 0x6c, 0x61, 0x00, 0xbb, 0x01, 0xfb, 0x03, 0x48, 0x1b,
+    0xda, 0x7c, 0x53, 0x00, 0xfa, 0x01, 0xad, 0x03, 0x4f, 0x62, 0x3c, 0xcb,
+    0xf6, 0x00, 0xfa, 0x00, 0x86, 0x03, 0x3f, 0xaf, 0x76, 0xc3, 0xe8, 0x00,
+    0xfa, 0xff, 0x42, 0x03, 0x4f, 0xea, 0xee, 0x79, 0x45, 0xff, 0x2f, 0x01,
+    0xf0, 0x03, 0x52, 0xaa, 0x5e, 0xe0, 0xf6, 0xff, 0x2f, 0x00, 0xac, 0x03,
+    0x5e, 0x67, 0x5b, 0xe2, 0xf9, 0xff, 0x2f, 0xff, 0x5c, 0x03, 0x0b, 0x1a,
+    0x89, 0x60, 0xee, 0xff, 0x2f, 0xfd, 0xdb, 0x03, 0x0c, 0x13, 0x63, 0x4c,
+    0x87, 0x01, 0x3f, 0x01, 0x70, 0x03, 0x4d, 0x21, 0x92, 0x5e, 0x3e, 0x01,
+    0x2d, 0x01, 0x62, 0x03, 0x49, 0x7c, 0x20, 0x99, 0xf2, 0x01, 0x2d, 0x00,
+    0x27, 0x03, 0x18, 0xd1, 0xfa, 0x7a, 0xf4, 0x01, 0x2d, 0xfe, 0xfc, 0x03,
+    0x08, 0xeb, 0xe3, 0x61, 0x24, 0xff, 0x45, 0x01, 0xff, 0x03, 0x55, 0xe4,
+    0xee, 0x70, 0x05, 0xff, 0x13, 0x01, 0xc1, 0x03, 0x50, 0x96, 0x31, 0xcb,
+    0xf3, 0xff, 0x13, 0x00, 0x65, 0x03, 0x40, 0x4c, 0x15, 0xb8, 0xe0, 0xff,
+    0x13, 0xff, 0x1d, 0x03, 0x19, 0x12, 0x7b, 0x63, 0xc1, 0x01, 0x3b, 0x01,
+    0x78, 0x03, 0x51, 0x30, 0xd7, 0x85, 0x1c, 0x01, 0x36, 0x01, 0x22, 0x03,
+    0x4c, 0x93, 0x0c, 0xac, 0xf3, 0x01, 0x36, 0xff, 0xd6, 0x03, 0x06, 0xed,
+    0x15, 0x76, 0x1d, 0xff, 0x28, 0x01, 0xea, 0x03, 0x4b, 0xe6, 0xfe, 0x80,
+    0x8b, 0xfe, 0xe8, 0x01, 0xa0, 0x03, 0x49, 0x94, 0xe6, 0xcd, 0xff, 0xfe,
+    0xe8, 0x00, 0x6d, 0x03, 0x2f, 0x44, 0xff, 0xc2, 0xf4, 0xfe, 0xe8, 0xff,
+    0x42, 0x03, 0x06, 0x13, 0x7e, 0x92, 0x1f, 0x01, 0x3b, 0x01, 0x78, 0x03,
+    0x4f, 0x19, 0xda, 0x9c, 0x31, 0x01, 0x07, 0x01, 0xac, 0x03, 0x4a, 0x6a,
+    0xed, 0xee, 0xfd, 0x01, 0x07, 0x00, 0x69, 0x03, 0x35, 0xb6, 0xdf, 0xe1,
+    0xf9, 0x01, 0x07, 0xff, 0x39, 0x03, 0x10, 0xeb, 0x43, 0xa6, 0x36, 0xff,
+    0x13, 0x01, 0xda, 0x03, 0x2e, 0xdd, 0xa8, 0xc3, 0x1e, 0xff, 0x28, 0x01,
+    0xad, 0x03, 0x4c, 0xb6, 0xc5, 0xff, 0x00, 0xff, 0x28, 0xff, 0x4c, 0x03,
+    0x31, 0x76, 0x86, 0x9b, 0xcf, 0xff, 0x28, 0xfe, 0x14, 0x03, 0x06, 0x4e,
+    0xcb, 0x2f, 0x76, 0x01, 0x43, 0x01, 0x68, 0x03, 0x4e, 0x55, 0x18, 0x39,
+    0x8c, 0x00, 0xf4, 0x01, 0xc3, 0x03, 0x4e, 0x9f, 0x5e, 0x92, 0xf1, 0x00,
+    0xf4, 0x00, 0x84, 0x03, 0x04, 0xe9, 0xa5, 0x8a, 0xff, 0x00, 0xf4, 0xff,
+    0x44, 0x03, 0x06, 0xeb, 0x36, 0x8a, 0x17, 0xff, 0x45, 0x01, 0xff, 0x03,
+    0x4d, 0xe4, 0xe7, 0x94, 0x26, 0xfe, 0xe2, 0x01, 0x91, 0x03, 0x50, 0x8e,
+    0xf8, 0xdd, 0xda, 0xfe, 0xe2, 0x00, 0x55, 0x03, 0x21, 0x35, 0xb1, 0xc5,
+    0xf2, 0xfe, 0xe2, 0xff, 0x0e, 0x03, 0x51, 0x13, 0x2d, 0xa1, 0x3e, 0x00,
+    0xfa, 0x01, 0xcd, 0x03, 0x4d, 0x62, 0x5b, 0xff, 0x00, 0x00, 0xfa, 0xff,
+    0x9f, 0x03, 0x3e, 0xad, 0xa0, 0xb2, 0xf0, 0x00, 0xfa, 0xfe, 0x63, 0x03,
+    0x07, 0xe8, 0x1e, 0x34, 0xf4, 0xfe, 0xdd, 0x01, 0x9a, 0x03, 0x52, 0xe1,
+    0x18, 0x41, 0x12, 0xfe, 0xf3, 0x01, 0xa5, 0x03, 0x4d, 0x8b, 0x05, 0x92,
+    0xec, 0xfe, 0xf3, 0x00, 0x56, 0x03, 0x27, 0x3a, 0x31, 0x7d, 0xd7, 0xfe,
+    0xf3, 0xff, 0x1a, 0x03, 0x0a, 0x13, 0x71, 0x52, 0x18, 0x01, 0x3f, 0x01,
+    0x70, 0x03, 0x4a, 0x1f, 0x19, 0x61, 0x41, 0x01, 0x28, 0x01, 0x72, 0x03,
+    0x4a, 0x74, 0xb2, 0xa0, 0xee, 0x01, 0x28, 0x00, 0x43, 0x03, 0x1f, 0xca,
+    0x4b, 0x88, 0xfd, 0x01, 0x28, 0xff, 0x14, 0x03, 0x8b, 0xec, 0x27, 0x68,
+    0x3d, 0xfe, 0xd3, 0x01, 0x8f, 0x03, 0x2f, 0x48, 0xae, 0xa9, 0xc0, 0xfe,
+    0xd3, 0xff, 0x5a, 0x03, 0x06, 0x13, 0x6e, 0x7d, 0x45, 0x01, 0x28, 0x01,
+    0x97, 0x03, 0x50, 0x19, 0x16, 0x88, 0x10, 0x00, 0xe6, 0x01, 0xcb, 0x03,
+    0x53, 0x61, 0x14, 0xe4, 0xe3, 0x00, 0xe6, 0x00, 0x83, 0x03, 0x49, 0xab,
+    0xc5, 0xd8, 0xf6, 0x00, 0xe6, 0xff, 0x2f, 0x03, 0x15, 0xeb, 0xf5, 0x77,
+    0x65, 0xfe, 0xbd, 0x01, 0x68, 0x03, 0x54, 0xd2, 0x1b, 0x93, 0x26, 0xfe,
+    0xc5, 0x01, 0x26, 0x03, 0x49, 0x6a, 0xd3, 0xbb, 0xed, 0xfe, 0xc5, 0xff,
+    0xce, 0x03, 0x05, 0x13, 0x70, 0x86, 0xa2, 0x00, 0xb3, 0x02, 0x03, 0x03,
+    0x4a, 0x18, 0x9a, 0x8f, 0x22, 0x01, 0x1e, 0x01, 0x95, 0x03, 0x4e, 0x6b,
+    0x2f, 0xd8, 0xec, 0x01, 0x1e, 0x00, 0x66, 0x03, 0x27, 0xc2, 0x3b, 0xc7,
+    0xda, 0x01, 0x1e, 0xff, 0x26, 0x03, 0x55, 0xeb, 0xcb, 0x9e, 0x31, 0xfe,
+    0xf3, 0x01, 0xba, 0x03, 0x52, 0x92, 0x91, 0xf7, 0xcc, 0xfe, 0xf3, 0x00,
+    0x5e, 0x03, 0x29, 0x3c, 0x7e, 0xe0, 0xb1, 0xfe, 0xf3, 0xff, 0x0e, 0x03,
+    0x0e, 0x13, 0xa4, 0xaf, 0xff, 0x01, 0x23, 0x01, 0x9a, 0x03, 0x38, 0x23,
+    0x02, 0xc6, 0x18, 0x01, 0x18, 0x01, 0x77, 0x03, 0x4c, 0x60, 0x4e, 0xff,
+    0x00, 0x01, 0x18, 0xff, 0x93, 0x03, 0x46, 0xb3, 0x7e, 0xb0, 0xf6, 0x01,
+    0x18, 0xfe, 0x5b, 0x03, 0x0c, 0xfe, 0xb9, 0x18, 0x0c, 0xff, 0xba, 0xfd,
+    0xed, 0x03, 0x15, 0xfb, 0x71, 0x00, 0x00, 0xff, 0xba, 0x01, 0xb3,
+    // Step 281358: 12 crossings, 2775 steps
+    0x01, 0xe6, 0x6e, 0x02, 0x64, 0x03, 0x4d, 0xe6, 0x00, 0x6d, 0xff, 0x00,
+    0x00, 0xff, 0xfc, 0x03, 0x09, 0xe6, 0x00, 0x3d, 0xf0, 0x00, 0x00, 0xfe,
+    0xc1, 0x03, 0x04, 0xe4, 0xf9, 0x35, 0x42, 0xff, 0x6d, 0x02, 0x13, 0x03,
+    0x56, 0xe0, 0xd0, 0x3b, 0xe0, 0xfe, 0xce, 0x01, 0x7b, 0x03, 0x4f, 0x7a,
+    0x13, 0x80, 0xd5, 0xfe, 0xce, 0x00, 0x1b, 0x03, 0x09, 0x1b, 0xb4, 0x57,
+    0xe6, 0xfe, 0xce, 0xfe, 0xd8, 0x03, 0x04, 0x13, 0x60, 0x4f, 0xa8, 0x00,
+    0x9c, 0x02, 0x10, 0x03, 0x55, 0x17, 0x3f, 0x56, 0xb4, 0x01, 0x07, 0x01,
+    0xb8, 0x03, 0x4f, 0x6e, 0x7b, 0xaf, 0xcb, 0x01, 0x07, 0x00, 0x5c, 0x03,
+    0x2d, 0xbf, 0x8e, 0x9a, 0xf1, 0x01, 0x07, 0xff, 0x19, 0x03, 0x4a, 0xeb,
+    0x93, 0x65, 0xa7, 0xfe, 0xd8, 0x01, 0x97, 0x03, 0x47, 0x95, 0xfa, 0xaf,
+    0xfc, 0xfe, 0xd8, 0x00, 0x68, 0x03, 0x2c, 0x43, 0xd9, 0xa4, 0xf1, 0xfe,
+    0xd8, 0xff, 0x45, 0x03, 0x08, 0x12, 0xcf, 0x79, 0x0e, 0x01, 0x13, 0x01,
+    0xb3, 0x03, 0x51, 0x19, 0xf6, 0x87, 0xb1, 0x00, 0xd1, 0x01, 0xd7, 0x03,
+    0x50, 0x5c, 0x28, 0xe8, 0xf0, 0x00, 0xd1, 0x00, 0x8b, 0x03, 0x58, 0x9d,
+    0x89, 0xe1, 0xf1, 0x00, 0xd1, 0xff, 0x44, 0x03, 0x09, 0xe5, 0x74, 0x63,
+    0xf9, 0x00, 0xd1, 0xfd, 0xdb, 0x03, 0x4e, 0xea, 0xdb, 0x53, 0xff, 0xfe,
+    0xd8, 0x01, 0x97, 0x03, 0x5e, 0x90, 0xa1, 0x9f, 0xda, 0xfe, 0xd8, 0x00,
+    0x57, 0x03, 0x10, 0x23, 0xe6, 0x79, 0xec, 0xfe, 0xd8, 0xfe, 0xd6, 0x03,
+    0x05, 0x13, 0xb9, 0x68, 0x59, 0x00, 0xed, 0x01, 0xda, 0x03, 0x52, 0x19,
+    0xb2, 0x6f, 0xbb, 0x01, 0x43, 0x01, 0x58, 0x03, 0x4f, 0x81, 0x20, 0xa8,
+    0xbe, 0x01, 0x43, 0x00, 0x08, 0x03, 0x07, 0xe4, 0xc6, 0x79, 0xeb, 0x01,
+    0x43, 0xfe, 0xc4, 0x03, 0x4d, 0xeb, 0x71, 0x74, 0x28, 0xff, 0x36, 0x01,
+    0xf5, 0x03, 0x4b, 0xae, 0xb7, 0xdb, 0xff, 0xff, 0x36, 0x00, 0xba, 0x03,
+    0x57, 0x73, 0x91, 0xe5, 0xf0, 0xff, 0x36, 0xff, 0x86, 0x03, 0x26, 0x2e,
+    0xf4, 0x80, 0xb9, 0xff, 0x36, 0xfe, 0x22, 0x03, 0x05, 0x12, 0x9e, 0x32,
+    0xe3, 0x01, 0x47, 0x01, 0x60, 0x03, 0x52, 0x17, 0xd1, 0x3b, 0x63, 0x01,
+    0x07, 0x01, 0xb4, 0x03, 0x51, 0x6b, 0xf9, 0x91, 0xfc, 0x01, 0x07, 0x00,
+    0x64, 0x03, 0x2d, 0xbf, 0x1a, 0x7d, 0xe7, 0x01, 0x07, 0xff, 0x19, 0x03,
+    0x07, 0xeb, 0x1f, 0x48, 0x9d, 0xfe, 0xb6, 0x01, 0x58, 0x03, 0x57, 0xe3,
+    0x03, 0x53, 0x6b, 0xfe, 0xdd, 0x01, 0x85, 0x03, 0x4e, 0x80, 0x1e, 0x9b,
+    0xe6, 0xfe, 0xdd, 0x00, 0x21, 0x03, 0x14, 0x27, 0x74, 0x75, 0xeb, 0xfe,
+    0xdd, 0xfe, 0xe2, 0x03, 0x0a, 0x13, 0x0c, 0x5f, 0x74, 0x00, 0xab, 0x02,
+    0x08, 0x03, 0x57, 0x1b, 0x8c, 0x72, 0x1b, 0x00, 0xdf, 0x01, 0xc4, 0x03,
+    0x4d, 0x67, 0x7d, 0xcf, 0xed, 0x00, 0xdf, 0x00, 0x60, 0x03, 0x4c, 0xaa,
+    0xb3, 0xbd, 0xf1, 0x00, 0xdf, 0xff, 0x24, 0x03, 0x23, 0xeb, 0x3d, 0x53,
+    0x12, 0xfe, 0xb9, 0x01, 0x60, 0x03, 0x4d, 0xbf, 0x14, 0x7b, 0x51, 0xfe,
+    0xbd, 0x00, 0xdd, 0x03, 0x3d, 0x5d, 0xf4, 0x8e, 0xf9, 0xfe, 0xbd, 0xff,
+    0xa2, 0x03, 0x07, 0x13, 0x6e, 0x5e, 0x1f, 0x01, 0x13, 0x01, 0xb3, 0x03,
+    0x4e, 0x19, 0x93, 0x6b, 0x13, 0x00, 0xd8, 0x01, 0xd2, 0x03, 0x53, 0x5b,
+    0x82, 0xc8, 0xf9, 0x00, 0xd8, 0x00, 0x92, 0x03, 0x5a, 0xa1, 0xac, 0xc1,
+    0xfd, 0x00, 0xd8, 0xff, 0x3e, 0x03, 0x13, 0xed, 0xc0, 0x3d, 0xda, 0x00,
+    0xd8, 0xfd, 0xce,
+    // Step 375834: 9 crossings, 1961 steps
+    0x01, 0x19, 0x6e, 0x02, 0x64, 0x03, 0x4d, 0x19, 0x00, 0x6d, 0xff, 0x00,
+    0x00, 0xff, 0xfc, 0x03, 0x0c, 0x19, 0x00, 0x3d, 0xf0, 0x00, 0x00, 0xfe,
+    0xc1, 0x03, 0x14, 0x1a, 0x3a, 0x30, 0xcc, 0x01, 0x3b, 0x01, 0x74, 0x03,
+    0x52, 0x32, 0x7e, 0x4c, 0x03, 0x01, 0x36, 0x01, 0x32, 0x03, 0x49, 0x95,
+    0xea, 0x78, 0xef, 0x01, 0x36, 0xff, 0xe2, 0x03, 0x06, 0xec, 0x73, 0x49,
+    0xa7, 0xff, 0x3e, 0x01, 0xf6, 0x03, 0x4f, 0xe6, 0x53, 0x53, 0xee, 0xfe,
+    0xf9, 0x01, 0xb0, 0x03, 0x49, 0x95, 0x3f, 0xa7, 0xfe, 0xfe, 0xf9, 0x00,
+    0x6d, 0x03, 0x37, 0x4a, 0x54, 0x9c, 0xe7, 0xfe, 0xf9, 0xff, 0x42, 0x03,
+    0x51, 0x14, 0x1b, 0x5f, 0x5e, 0x00, 0xdf, 0x01, 0xe5, 0x03, 0x4f, 0x5a,
+    0xcf, 0xc4, 0xf9, 0x00, 0xdf, 0x00, 0x99, 0x03, 0x4d, 0x9f, 0xc4, 0xc2,
+    0xf4, 0x00, 0xdf, 0xff, 0x56, 0x03, 0x0c, 0xe2, 0xfa, 0x60, 0xe3, 0x00,
+    0xdf, 0xfe, 0x1a, 0x03, 0x51, 0xeb, 0x71, 0x4c, 0xc0, 0xfe, 0xbd, 0x01,
+    0x68, 0x03, 0x49, 0x85, 0x46, 0x8a, 0xe6, 0xfe, 0xbd, 0x00, 0x1d, 0x03,
+    0x13, 0x29, 0x32, 0x68, 0xf9, 0xfe, 0xbd, 0xfe, 0xf2, 0x03, 0x05, 0x13,
+    0xc8, 0x54, 0xd9, 0x00, 0xc2, 0x01, 0xfa, 0x03, 0x4c, 0x19, 0x01, 0x5d,
+    0x4f, 0x01, 0x1e, 0x01, 0x95, 0x03, 0x4b, 0x6d, 0xd1, 0xa7, 0xe1, 0x01,
+    0x1e, 0x00, 0x5e, 0x03, 0x28, 0xc1, 0x84, 0x96, 0xde, 0x01, 0x1e, 0xff,
+    0x2a, 0x03, 0x30, 0xec, 0x0a, 0x6c, 0x3b, 0xfe, 0xce, 0x01, 0x88, 0x03,
+    0x56, 0xb1, 0xdc, 0xa2, 0xf5, 0xfe, 0xca, 0x00, 0xbf, 0x03, 0x2f, 0x49,
+    0x97, 0xa8, 0xca, 0xfe, 0xca, 0xff, 0x5f, 0x03, 0x4f, 0x12, 0xde, 0x7d,
+    0x10, 0x01, 0x4a, 0x01, 0x58, 0x03, 0x54, 0x78, 0xc8, 0xb5, 0xea, 0x01,
+    0x4a, 0x00, 0x14, 0x03, 0x07, 0xe5, 0x26, 0x84, 0xd4, 0x01, 0x4a, 0xfe,
+    0xbc, 0x03, 0x12, 0xeb, 0xfd, 0x7e, 0xe0, 0xfe, 0xd8, 0x01, 0x97, 0x03,
+    0x56, 0xd6, 0x39, 0x97, 0xc9, 0xfe, 0xca, 0x01, 0x3a, 0x03, 0x4d, 0x6d,
+    0xf4, 0xc6, 0xe6, 0xfe, 0xca, 0xff, 0xda, 0x03, 0x50, 0x12, 0xb5, 0x8f,
+    0xea, 0x01, 0x4a, 0x01, 0x58, 0x03, 0x52, 0x79, 0xea, 0xc8, 0xd8, 0x01,
+    0x4a, 0x00, 0x10, 0x03, 0x16, 0xe3, 0xb3, 0x98, 0xee, 0x01, 0x4a, 0xfe,
+    0xc0, 0x03, 0x32, 0xff, 0x00, 0x7b, 0x19, 0xff, 0xad, 0xfe, 0xcd,
+    // Step 464775: 32 crossings, 6773 steps
+    0x01, 0xe6, 0x6e, 0x02, 0x64, 0x03, 0x4d, 0xe6, 0x00, 0x6d, 0xff, 0x00,
+    0x00, 0xff, 0xfc, 0x03, 0x08, 0xe6, 0x00, 0x3d, 0xf0, 0x00, 0x00, 0xfe,
+    0xc1, 0x03, 0x05, 0xe5, 0x6c, 0x36, 0xf1, 0xff, 0x55, 0x02, 0x08, 0x03,
+    0x4a, 0xdf, 0xe7, 0x3e, 0xe0, 0xfe, 0xca, 0x01, 0x70, 0x03, 0x57, 0x86,
+    0x2f, 0x7d, 0xe9, 0xfe, 0xca, 0x00, 0x41, 0x03, 0x0b, 0x1c, 0xb3, 0x57,
+    0xf7, 0xfe, 0xca, 0xfe, 0xdc, 0x03, 0x53, 0x11, 0x6c, 0x4d, 0xc2, 0x00,
+    0xd8, 0x01, 0xe6, 0x03, 0x57, 0x57, 0x96, 0xb4, 0xff, 0x00, 0xd8, 0x00,
+    0x92, 0x03, 0x4b, 0xa1, 0x21, 0xaa, 0xe4, 0x00, 0xd8, 0xff, 0x2e, 0x03,
+    0x1e, 0xe0, 0x87, 0x40, 0xfa, 0x00, 0xd8, 0xfd, 0xfb, 0x03, 0x07, 0xf9,
+    0xe3, 0x01, 0xdc, 0x00, 0xd8, 0x01, 0xd9, 0x03, 0x11, 0xff, 0x00, 0x0c,
+    0xc9, 0xfe, 0xff, 0x01, 0xc7, 0x03, 0x08, 0xee, 0x58, 0x2a, 0x76, 0xff,
+    0x21, 0x01, 0xe5, 0x03, 0x4b, 0xe5, 0xcf, 0x37, 0xeb, 0xfe, 0xf9, 0x01,
+    0xc1, 0x03, 0x56, 0x98, 0xd6, 0x8e, 0xec, 0xfe, 0xf9, 0x00, 0x8d, 0x03,
+    0x2e, 0x40, 0x94, 0x83, 0xec, 0xfe, 0xf9, 0xff, 0x2d, 0x03, 0x54, 0x13,
+    0x65, 0x50, 0xc9, 0x01, 0x01, 0x01, 0xc3, 0x03, 0x50, 0x67, 0x95, 0xac,
+    0xf7, 0x01, 0x01, 0x00, 0x6b, 0x03, 0x36, 0xb7, 0xc2, 0x9b, 0xcb, 0x01,
+    0x01, 0xff, 0x23, 0x03, 0x04, 0xeb, 0x9d, 0x59, 0x6f, 0xfe, 0xbd, 0x01,
+    0x64, 0x03, 0x4e, 0xe7, 0x6c, 0x60, 0x2f, 0xff, 0x06, 0x01, 0xc1, 0x03,
+    0x4c, 0x9b, 0x2c, 0xb8, 0xf4, 0xff, 0x06, 0x00, 0x82, 0x03, 0x41, 0x50,
+    0xe1, 0xb1, 0xd0, 0xff, 0x06, 0xff, 0x4a, 0x03, 0x4e, 0x13, 0x90, 0x65,
+    0x8f, 0x00, 0xf4, 0x01, 0xd4, 0x03, 0x4e, 0x5d, 0xd7, 0xc3, 0xf3, 0x00,
+    0xf4, 0x00, 0x94, 0x03, 0x49, 0xa8, 0x1d, 0xc0, 0xfe, 0x00, 0xf4, 0xff,
+    0x55, 0x03, 0x06, 0xec, 0x11, 0x69, 0xed, 0xfe, 0xce, 0x01, 0x88, 0x03,
+    0x47, 0xe5, 0xdd, 0x74, 0x2f, 0xfe, 0xff, 0x01, 0xb3, 0x03, 0x4f, 0x9e,
+    0xb4, 0xc4, 0xf0, 0xfe, 0xff, 0x00, 0x90, 0x03, 0x3e, 0x4f, 0x88, 0xbf,
+    0xfd, 0xfe, 0xff, 0xff, 0x4c, 0x03, 0x16, 0x13, 0x83, 0x79, 0x7f, 0x01,
+    0x4a, 0x01, 0x58, 0x03, 0x51, 0x2f, 0x4a, 0x95, 0x08, 0x01, 0x43, 0x01,
+    0x12, 0x03, 0x46, 0x95, 0x76, 0xb7, 0xf7, 0x01, 0x43, 0xff, 0xc7, 0x03,
+    0x4f, 0xeb, 0x37, 0x84, 0x4d, 0xff, 0x4d, 0x02, 0x03, 0x03, 0x19, 0xb3,
+    0xeb, 0xf1, 0xfa, 0xff, 0x4d, 0x00, 0xc0, 0x03, 0x51, 0xa2, 0x6b, 0xfe,
+    0x69, 0xff, 0x4d, 0xff, 0xaf, 0x03, 0x3f, 0x69, 0xb8, 0xb0, 0xdb, 0xff,
+    0x4d, 0xfe, 0x63, 0x03, 0x07, 0x3f, 0x2a, 0x30, 0x7b, 0x01, 0x36, 0x01,
+    0x80, 0x03, 0x4d, 0x46, 0xaa, 0x3c, 0x1f, 0x01, 0x18, 0x01, 0x98, 0x03,
+    0x4d, 0x9a, 0xf2, 0x87, 0xf1, 0x01, 0x18, 0x00, 0x5c, 0x03, 0x1c, 0xed,
+    0x0a, 0x77, 0x6e, 0xfe, 0xf9, 0x01, 0xc1, 0x03, 0x4e, 0xce, 0xf4, 0xa1,
+    0xbd, 0xfe, 0xed, 0x01, 0x49, 0x03, 0x51, 0x7b, 0x4d, 0xd5, 0xd2, 0xfe,
+    0xed, 0x00, 0x09, 0x03, 0x12, 0x24, 0x6e, 0xa4, 0xe0, 0xfe, 0xed, 0xfe,
+    0xbd, 0x03, 0x23, 0x13, 0x20, 0x8f, 0x20, 0x01, 0x47, 0x01, 0x60, 0x03,
+    0x50, 0x3f, 0x49, 0xb7, 0x60, 0x01, 0x43, 0x00, 0xdd, 0x03, 0x3b, 0xa4,
+    0x32, 0xc9, 0xe0, 0x01, 0x43, 0xff, 0x95, 0x03, 0x05, 0xec, 0x32, 0x98,
+    0xd9, 0xff, 0x21, 0x01, 0xe5, 0x03, 0x4c, 0xe6, 0x9f, 0xa0, 0xe2, 0xfe,
+    0xd3, 0x01, 0x7f, 0x03, 0x4f, 0x8d, 0x3e, 0xe4, 0xef, 0xfe, 0xd3, 0x00,
+    0x48, 0x03, 0x1b, 0x30, 0x55, 0xc9, 0xb6, 0xfe, 0xd3, 0xff, 0x04, 0x03,
+    0x08, 0x13, 0x08, 0xac, 0x4a, 0x00, 0x93, 0x02, 0x13, 0x03, 0x30, 0x19,
+    0x6c, 0xbb, 0x8d, 0x00, 0xdf, 0x01, 0xcc, 0x03, 0x57, 0x43, 0x52, 0xff,
+    0x00, 0x00, 0xdf, 0xff, 0x3a, 0x03, 0x21, 0x8f, 0x43, 0x7f, 0xe2, 0x00,
+    0xdf, 0xfd, 0xd6, 0x03, 0x0a, 0xaa, 0x9e, 0x34, 0xbe, 0xff, 0x21, 0x01,
+    0xe5, 0x03, 0x53, 0xa3, 0x02, 0x47, 0xe7, 0xff, 0x4d, 0x01, 0xe2, 0x03,
+    0x59, 0x68, 0xe9, 0xad, 0xda, 0xff, 0x4d, 0x00, 0x8e, 0x03, 0x23, 0x2a,
+    0x9c, 0xa0, 0xb4, 0xff, 0x4d, 0xff, 0x22, 0x03, 0x04, 0x13, 0x82, 0x7c,
+    0x3d, 0x00, 0xb3, 0x01, 0xff, 0x03, 0x51, 0x17, 0xe6, 0x82, 0x98, 0x01,
+    0x3b, 0x01, 0x6c, 0x03, 0x53, 0x7b, 0x7d, 0xc1, 0xe3, 0x01, 0x3b, 0x00,
+    0x20, 0x03, 0x0a, 0xe1, 0x89, 0x95, 0xd9, 0x01, 0x3b, 0xfe, 0xcc, 0x03,
+    0x04, 0xeb, 0xe7, 0x8c, 0x76, 0xff, 0x4d, 0x01, 0xff, 0x03, 0x4e, 0xe7,
+    0x83, 0x92, 0xd9, 0xfe, 0xc5, 0x01, 0x70, 0x03, 0x55, 0x87, 0x9d, 0xd2,
+    0xeb, 0xfe, 0xc5, 0x00, 0x31, 0x03, 0x0c, 0x1f, 0x1b, 0xa9, 0xe6, 0xfe,
+    0xc5, 0xfe, 0xd4, 0x03, 0x08, 0x12, 0x1f, 0x9e, 0x3b, 0x01, 0x13, 0x01,
+    0xb3, 0x03, 0x49, 0x1b, 0xc9, 0xa9, 0xf8, 0x01, 0x3f, 0x01, 0x58, 0x03,
+    0x53, 0x76, 0xbb, 0xe1, 0xed, 0x01, 0x3f, 0x00, 0x2d, 0x03, 0x0d, 0xde,
+    0x22, 0xb9, 0xf7, 0x01, 0x3f, 0xfe, 0xd9, 0x03, 0x07, 0xeb, 0xfd, 0xac,
+    0xbd, 0xfe, 0xed, 0x01, 0xb3, 0x03, 0x30, 0xe6, 0x03, 0xb9, 0xd2, 0xff,
+    0x2f, 0x01, 0xd7, 0x03, 0x51, 0xbe, 0xc9, 0xfe, 0x2e, 0xff, 0x2f, 0xff,
+    0x2b, 0x03, 0x27, 0x7c, 0x97, 0x86, 0xe5, 0xff, 0x2f, 0xfd, 0xdf, 0x03,
+    0x16, 0x5e, 0xac, 0x2c, 0x5f, 0x01, 0x23, 0x01, 0x9a, 0x03, 0x52, 0x77,
+    0x9e, 0x4d, 0x3d, 0x01, 0x28, 0x01, 0x4d, 0x03, 0x15, 0xd6, 0x78, 0x82,
+    0xbe, 0x01, 0x28, 0xff, 0xfd, 0x03, 0x20, 0xec, 0x9a, 0x81, 0x40, 0xff,
+    0x6d, 0x02, 0x13, 0x03, 0x39, 0xda, 0x2d, 0xbd, 0x23, 0xff, 0x6d, 0x01,
+    0x9d, 0x03, 0x47, 0xb9, 0x5b, 0xff, 0x00, 0xff, 0x6d, 0xff, 0x7a, 0x03,
+    0x44, 0x90, 0x79, 0xb1, 0xf2, 0xff, 0x6d, 0xfe, 0x57, 0x03, 0x4f, 0x6a,
+    0xd2, 0x21, 0x1e, 0x01, 0x18, 0x01, 0xac, 0x03, 0x29, 0xc1, 0x4a, 0x73,
+    0xf7, 0x01, 0x18, 0x00, 0x69, 0x03, 0x5e, 0xec, 0x00, 0x79, 0x89, 0xfe,
+    0xb6, 0x01, 0x58, 0x03, 0x4f, 0x72, 0xbc, 0xb1, 0xe7, 0xfe, 0xb6, 0xff,
+    0xd7, 0x03, 0x0a, 0x0c, 0xd1, 0x73, 0xf1, 0xfe, 0xb6, 0xfe, 0x93, 0x03,
+    0x04, 0x00, 0x00, 0x65, 0x13, 0x01, 0x47, 0x01, 0x60, 0x03, 0x51, 0x03,
+    0xe5, 0x6c, 0x15, 0x00, 0xdf, 0x01, 0xd9, 0x03, 0x4f, 0x4a, 0x99, 0xcd,
+    0xcd, 0x00, 0xdf, 0x00, 0x8d, 0x03, 0x58, 0x8f, 0x8e, 0xc7, 0xfd, 0x00,
+    0xdf, 0xff, 0x49, 0x03, 0x21, 0xdc, 0x5e, 0x4b, 0xf2, 0x00, 0xdf, 0xfd,
+    0xe1, 0x03, 0x08, 0xf9, 0x2c, 0x00, 0x00, 0x00, 0xdf, 0x01, 0xfd, 0x03,
+    0x05, 0xfe, 0xc8, 0x0e, 0x5c, 0xff, 0x4d, 0x02, 0x03, 0x03, 0x0d, 0xf9,
+    0xda, 0x16, 0xe1, 0xfe, 0xd3, 0x01, 0x8f, 0x03, 0x0c, 0xeb, 0x82, 0x2b,
+    0xcc, 0xff, 0x36, 0x01, 0xf1, 0x03, 0x57, 0xe0, 0x82, 0x41, 0x45, 0xfe,
+    0xdd, 0x01, 0x85, 0x03, 0x4c, 0x7d, 0x9d, 0x89, 0xbf, 0xfe, 0xdd, 0x00,
+    0x21, 0x03, 0x13, 0x27, 0x39, 0x65, 0xf5, 0xfe, 0xdd, 0xfe, 0xea, 0x03,
+    0x05, 0x13, 0xf9, 0x51, 0x72, 0x01, 0x36, 0x01, 0x7c, 0x03, 0x49, 0x18,
+    0xae, 0x5a, 0x69, 0x00, 0xdf, 0x01, 0xd5, 0x03, 0x51, 0x58, 0x66, 0xb5,
+    0xfb, 0x00, 0xdf, 0x00, 0xaa, 0x03, 0x52, 0x9f, 0x1a, 0xb7, 0xcc, 0x00,
+    0xdf, 0xff, 0x5e, 0x03, 0x07, 0xe6, 0xae, 0x4e, 0xb5, 0x00, 0xdf, 0xfe,
+    0x0e, 0x03, 0x4c, 0xea, 0xde, 0x44, 0x85, 0xfe, 0xf3, 0x01, 0xb6, 0x03,
+    0x49, 0x9b, 0x17, 0x98, 0xe5, 0xfe, 0xf3, 0x00, 0x7f, 0x03, 0x3a, 0x4e,
+    0x76, 0x92, 0xed, 0xfe, 0xf3, 0xff, 0x54, 0x03, 0x0b, 0x13, 0x2c, 0x55,
+    0x12, 0x00, 0xf4, 0x01, 0xd4, 0x03, 0x58, 0x1f, 0x12, 0x66, 0xe8, 0x01,
+    0x18, 0x01, 0x83, 0x03, 0x4e, 0x7f, 0x64, 0xae, 0xc7, 0x01, 0x18, 0x00,
+    0x1b, 0x03, 0x18, 0xd4, 0xc5, 0x86, 0xe6, 0x01, 0x18, 0xfe, 0xdb, 0x03,
+    0x0c, 0xed, 0x66, 0x6a, 0xa5, 0xff, 0x2f, 0x01, 0xf0, 0x03, 0x4c, 0xe4,
+    0xf2, 0x82, 0x09, 0xff, 0x5c, 0x01, 0xe7, 0x03, 0x49, 0xb4, 0x67, 0xe4,
+    0xf7, 0xff, 0x5c, 0x00, 0xb0, 0x03, 0x47, 0x85, 0xc7, 0xec, 0xf8, 0xff,
+    0x5c, 0xff, 0x85, 0x03, 0x3b, 0x58, 0x6e, 0xa2, 0xf7, 0xff, 0x5c, 0xfe,
+    0x62, 0x03, 0x10, 0x34, 0x49, 0x2c, 0x86, 0x01, 0x28, 0x01, 0x97, 0x03,
+    0x50, 0x47, 0xee, 0x42, 0x5d, 0x01, 0x4a, 0x01, 0x27, 0x03, 0x31, 0xaf,
+    0x23, 0x6b, 0xf0, 0x01, 0x4a, 0xff, 0xdf, 0x03, 0x14, 0xec, 0x5c, 0x55,
+    0xbe, 0xff, 0x55, 0x02, 0x08, 0x03, 0x54, 0xdd, 0xd2, 0x7b, 0x37, 0xff,
+    0x45, 0x01, 0xb5, 0x03, 0x48, 0xa0, 0x7f, 0xd2, 0xc8, 0xff, 0x45, 0x00,
+    0x5d, 0x03, 0x54, 0x6b, 0xf0, 0xc3, 0xfc, 0xff, 0x45, 0xff, 0x36, 0x03,
+    0x0d, 0x2e, 0x9e, 0x49, 0xe2, 0xff, 0x45, 0xfd, 0xde, 0x03, 0x13, 0x26,
+    0x87, 0x31, 0x41, 0x01, 0x1e, 0x01, 0xa5, 0x03, 0x54, 0x3a, 0xf2, 0x4f,
+    0x0c, 0x01, 0x13, 0x01, 0x69, 0x03, 0x57, 0x95, 0x08, 0x8d, 0xdc, 0x01,
+    0x13, 0x00, 0x11, 0x03, 0x0d, 0xf2, 0x56, 0x57, 0xe5, 0x01, 0x13, 0xfe,
+    0xad, 0x03, 0x1e, 0xfe, 0xbb, 0x46, 0x1a, 0xff, 0xbb, 0xfe, 0xd9,
+    0x00
+};
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * File:   rally.h
+ *
+ * Attract mode rallies
+ * Mode 0 rallies recorded on the host with the game of main.c and played
+ * back in mode 0 instead of the physics and the autoplayers (RALLY_step()).
+ * rally.c is generated by tools/rallygen.c, which picks the longest
+ * exchanges that fit its ROM budget. A table with no rallies, or a court in
+ * EEPROM that differs from RALLY_Court, plays the live game.
+ *
+ * The path is stored as flight segments: where the ball is and how fast it
+ * goes, then playback adds the velocity to the position and gravity to the
+ * velocity for n steps, three 16 bit adds. A bounce, a hit or the drift of
+ * the integer gravity starts a new segment, the generator checks every step
+ * against the recording (RALLY_Error game units at most).
+ *
+ * RALLY_Data, records in game units (the view is applied on playback), 8.8
+ * and signed 8.8 per step values high byte first:
+ *   RALLY_Serve x y            new ball at x, y
+ *   RALLY_Wait n               n steps waiting to be served
+ *   RALLY_Fly n x y vx vy      n steps from x, y (8.8) at vx, vy (8.8)
+ *   RALLY_Wrap                 end of the table, back to the first rally
+ *
+ * Only built with RALLY defined.
+ */
+
+#ifndef RALLY_H
+#define	RALLY_H
+
+#define RALLY_Wrap       0
+#define RALLY_Serve      1
+#define RALLY_Wait       2
+#define RALLY_Fly        3
+
+#define RALLY_Gravity    4      // 8.8 per step, g * ts is 4.096
+#define RALLY_Error      1      // Game units off the recording at most
+
+// COURT bytes the rallies depend on: all but the view
+#define RALLY_CourtSize  9
+
+#if defined(RALLY)
+
+extern rom unsigned char RALLY_Court[RALLY_CourtSize];
+extern rom unsigned char RALLY_Data[];
+
+#endif
+
+#endif	/* RALLY_H */
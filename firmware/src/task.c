@@ -0,0 +1,96 @@
+#include <p18cxxx.h>
+#include "prof.h"
+#include "task.h"
+
+#pragma udata
+
+TASK_FN       TASK_Fn[TASK_Max];
+unsigned char TASK_Stage[TASK_Max];
+unsigned char TASK_Count   = 0;
+unsigned char TASK_Pending = 0;          // Bit per task, work left this frame
+unsigned char TASK_Next    = 0;          // Round robin
+
+#if defined(PROFILE)
+unsigned int  TASK_Cycles[TASK_Max];
+unsigned char TASK_Slices[TASK_Max];
+unsigned int  TASK_SliceMax[TASK_Max];
+unsigned int  TASK_Cur[TASK_Max];        // This frame
+unsigned char TASK_CurSlices[TASK_Max];
+#endif
+
+#pragma code
+
+void TASK_init(void){
+    TASK_Count   = 0;
+    TASK_Pending = 0;
+    TASK_Next    = 0;
+}
+
+void TASK_add(TASK_FN fn, unsigned char nStage){
+    if (TASK_Count >= TASK_Max){
+        return;
+    }
+    TASK_Fn[TASK_Count]    = fn;
+    TASK_Stage[TASK_Count] = nStage;
+#if defined(PROFILE)
+    TASK_Cycles[TASK_Count]    = 0;
+    TASK_Slices[TASK_Count]    = 0;
+    TASK_SliceMax[TASK_Count]  = 0;
+    TASK_Cur[TASK_Count]       = 0;
+    TASK_CurSlices[TASK_Count] = 0;
+#endif
+    TASK_Count++;
+}
+
+void TASK_frame(void){
+#if defined(PROFILE)
+    unsigned char i;
+
+    for (i = 0; i < TASK_Count; i++){
+        TASK_Cycles[i]    = TASK_Cur[i];
+        TASK_Slices[i]    = TASK_CurSlices[i];
+        TASK_Cur[i]       = 0;
+        TASK_CurSlices[i] = 0;
+    }
+#endif
+    TASK_Pending = (unsigned char) ((1 << TASK_Count) - 1);
+}
+
+void TASK_run(void){
+    unsigned char i;
+#if defined(PROFILE)
+    unsigned int  iStart, iLen;
+#endif
+
+    if (TASK_Pending == 0){
+        return;
+    }
+    // Next pending one after the last that ran
+    i = TASK_Next;
+    while ((TASK_Pending & (1 << i)) == 0){
+        i = (i + 1 < TASK_Count) ? i + 1 : 0;
+    }
+    TASK_Next = (i + 1 < TASK_Count) ? i + 1 : 0;
+
+#if defined(PROFILE)
+    iStart = PROF_ticks();
+#endif
+    if (TASK_Fn[i]() == PT_Ended){
+        TASK_Pending &= ~(1 << i);
+    }
+#if defined(PROFILE)
+    iLen = PROF_ticks() - iStart;
+    PROF_stage(TASK_Stage[i]);
+    TASK_Cur[i] += iLen;
+    TASK_CurSlices[i]++;
+    if (iLen > TASK_SliceMax[i]){
+        TASK_SliceMax[i] = iLen;
+    }
+#endif
+}
+
+void TASK_flush(void){
+    while (TASK_Pending){
+        TASK_run();
+    }
+}
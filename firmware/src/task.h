@@ -0,0 +1,64 @@
+/*
+ * File:   task.h
+ *
+ * Main loop tasks
+ * Cooperative scheduler for the main loop work that isn't beam output.
+ * Each task is a protothread (pt.h) that does one frame's worth of work in
+ * slices and ends. TASK_frame() makes them all pending, the main loop calls
+ * TASK_run() between beam segments (a trail, a ball, a ground pass), one
+ * slice of the next pending task each time, round robin, and TASK_flush()
+ * at the end of the frame runs what is left so no task falls behind. A
+ * long job yields between its pieces and the picture is drawn in between
+ * instead of waiting for all of it.
+ *
+ * PROFILE builds time every slice with Timer1: ticks and slices per task
+ * in the last frame and the longest slice since power on. The slice is
+ * also charged to the task's PROF stage, so call TASK_run() right after a
+ * PROF_stage() mark.
+ */
+
+#ifndef TASK_H
+#define	TASK_H
+
+#include "pt.h"
+
+#define TASK_Max     4
+
+// A task: PT_Waiting, PT_Yielded or PT_Ended, see pt.h
+typedef unsigned char (*TASK_FN)(void);
+
+#if defined(PROFILE)
+
+extern unsigned char TASK_Count;
+extern unsigned int  TASK_Cycles[TASK_Max];    // Last frame
+extern unsigned char TASK_Slices[TASK_Max];    // Last frame
+extern unsigned int  TASK_SliceMax[TASK_Max];  // Longest slice so far
+
+#endif
+
+/**
+ * No tasks
+ */
+void TASK_init(void);
+
+/**
+ * Add a task, nStage is the PROF stage its slices are charged to
+ */
+void TASK_add(TASK_FN fn, unsigned char nStage);
+
+/**
+ * New frame: every task is pending again
+ */
+void TASK_frame(void);
+
+/**
+ * One slice of the next pending task, if any
+ */
+void TASK_run(void);
+
+/**
+ * Slices until no task is pending
+ */
+void TASK_flush(void);
+
+#endif	/* TASK_H */
@@ -0,0 +1,78 @@
+#include <p18cxxx.h>
+#include "typedefs.h"
+#include "timer.h"
+#include "uart.h"
+#include "prof.h"
+#include "telem.h"
+
+#if defined(TELEMETRY)
+
+#pragma udata
+
+TELEM_REC     Telem;
+word          TELEM_Frame   = 0;
+byte          TELEM_Dropped = 0;
+byte          TELEM_Frames  = 0;    // Gathered since the last record
+byte          TELEM_Ms      = 0;
+byte          TELEM_Btn     = 0xFF;
+byte          TELEM_LatMs   = PROF_LatNone;
+
+#pragma code
+
+void TELEM_init(void){
+    TELEM_Frame   = 0;
+    TELEM_Dropped = 0;
+    TELEM_Frames  = 0;
+    TELEM_Ms      = 0;
+    TELEM_Btn     = 0xFF;
+    TELEM_LatMs   = PROF_LatNone;
+    UART_init();
+}
+
+void TELEM_send(void){
+    unsigned char i;
+    unsigned char nSum = 0;
+    unsigned int  iMs;
+    byte *p = (byte *) &Telem;
+
+    Telem.Frame = TELEM_Frame++;
+    if (TELEM_Frames < 255){
+        TELEM_Frames++;
+    }
+    iMs = (unsigned int) TELEM_Ms + Telem.FrameMs;
+    TELEM_Ms   = (iMs > 255) ? 255 : (unsigned char) iMs;
+    TELEM_Btn &= Telem.Flags;
+    if (Telem.LatMs != PROF_LatNone){
+        TELEM_LatMs = Telem.LatMs;
+    }
+    if (TELEM_Ms < TELEM_PeriodMs){
+        return;
+    }
+
+    Telem.Sync     = TELEM_Sync;
+    Telem.Flags    = (Telem.Flags & 0b11111100) | (TELEM_Btn & 0b00000011);
+    Telem.FrameMs  = TELEM_Ms;
+    Telem.Frames   = TELEM_Frames;
+    Telem.LatMs    = TELEM_LatMs;
+    TELEM_Frames   = 0;
+    TELEM_Ms       = 0;
+    TELEM_Btn      = 0xFF;
+    TELEM_LatMs    = PROF_LatNone;
+
+    if (UART_txFree() < sizeof(TELEM_REC)){
+        TELEM_Dropped++;
+        return;
+    }
+    Telem.Dropped = TELEM_Dropped;
+
+    for (i = 0; i < sizeof(TELEM_REC) - 1; i++){
+        nSum += p[i];
+    }
+    Telem.Check = (unsigned char) (0 - nSum);
+
+    for (i = 0; i < sizeof(TELEM_REC); i++){
+        UART_txPut(p[i]);
+    }
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * File:   telem.h
+ *
+ * Telemetry
+ * One fixed size binary record over the USART for the frames of every
+ * TELEM_PeriodMs, dropped (and counted) when the TX ring has no room for it,
+ * so the main loop never waits. Only built with TELEMETRY defined.
+ * tools/telem2csv.py decodes it.
+ *
+ * Rate: a record is 240 bits on the line, 12.5 ms at 19200 baud, so the line
+ * carries at most 80 records/s. A frame takes less than that with
+ * CLOCK_HSPLL, so records aren't per frame: the frames are gathered until
+ * they add up to TELEM_PeriodMs and one record covers them, at most 50
+ * records/s, which the 64 byte ring drains between two of them.
+ *
+ * Record, 24 bytes, little endian:
+ *   0     0xA5 sync
+ *   1-2   Frame counter, of the last frame covered
+ *   3-4   Ball x, y (DAC codes)
+ *   5-6   Ball Vx, Vy (signed, 1/16 per step)
+ *   7-8   L_angle, R_angle
+ *   9     Flags: b0 L_Btn, b1 R_Btn (0 if pressed in any frame covered),
+ *         b2 nSide, b3 nDeadBall, b4 nDebug, b5-6 nMode
+ *   10    nBallHits
+ *   11    Time covered, ms (saturates at 255)
+ *   12-19 Stage Timer1 ticks / 64 of the last frame (PROFILE builds, 0
+ *         otherwise, see prof.h)
+ *   20    Records dropped so far, wraps
+ *   21    Frames covered
+ *   22    Input to photon latency of the last probe that ended in the
+ *         frames covered, ms (PROFILE builds, 255 none)
+ *   23    Checksum, all 24 bytes add up to 0
+ */
+
+#ifndef TELEM_H
+#define	TELEM_H
+
+#define TELEM_Sync    0xA5
+// Time one record covers at least, ms
+#define TELEM_PeriodMs 20
+
+typedef struct _TELEM_REC
+{
+    byte        Sync;
+    word        Frame;
+    byte        x;
+    byte        y;
+    signed char Vx;
+    signed char Vy;
+    byte        L_Angle;
+    byte        R_Angle;
+    byte        Flags;
+    byte        Hits;
+    byte        FrameMs;
+    byte        Stage[8];
+    byte        Dropped;
+    byte        Frames;
+    byte        LatMs;
+    byte        Check;
+} TELEM_REC;
+
+#if defined(TELEMETRY)
+
+// Filled in by the caller every frame, then TELEM_send(), which sends it
+// once the frames gathered cover TELEM_PeriodMs
+extern TELEM_REC Telem;
+
+void TELEM_init(void);
+void TELEM_send(void);
+
+#else
+
+#define TELEM_init()
+
+#endif
+
+#endif	/* TELEM_H */
@@ -0,0 +1,56 @@
+#include <p18cxxx.h>
+#include "timer.h"
+
+#pragma udata
+
+unsigned char TIMER_Seconds = 0;
+
+unsigned int  TIMER_Last    = 0;    // Timer0 at the previous update
+unsigned int  TIMER_Acc     = 0;    // Ticks not yet worth a ms
+unsigned int  TIMER_Ms      = 0;    // ms into the current second
+
+#pragma code
+
+void TIMER_init(void){
+    TMR0H = 0;
+    TMR0L = 0;
+    T0CON = TIMER_T0CON;
+    TIMER_Last    = 0;
+    TIMER_Acc     = 0;
+    TIMER_Ms      = 0;
+    TIMER_Seconds = 0;
+}
+
+unsigned int TIMER_ticks(void){
+    unsigned int iNow;
+
+    // TMR0H is latched when TMR0L is read
+    iNow  = TMR0L;
+    iNow |= (unsigned int) TMR0H << 8;
+    return iNow;
+}
+
+unsigned char TIMER_update(void){
+    unsigned int iNow;
+    unsigned int iMs;
+
+    iNow = TIMER_ticks();
+
+    TIMER_Acc += iNow - TIMER_Last;
+    TIMER_Last = iNow;
+
+    iMs        = TIMER_Acc / TIMER_TicksPerMs;
+    TIMER_Acc -= iMs * TIMER_TicksPerMs;
+
+    TIMER_Ms     += iMs;
+    TIMER_Seconds = 0;
+    while (TIMER_Ms >= 1000){
+        TIMER_Ms -= 1000;
+        TIMER_Seconds++;
+    }
+
+    if (iMs > 255){
+        return 255;
+    }
+    return (unsigned char) iMs;
+}
@@ -0,0 +1,52 @@
+/*
+ * File:   timer.h
+ *
+ * Clock and timing
+ * Timer0 runs free at Fosc/4 through a prescaler picked so one millisecond
+ * is a whole number of ticks. Game delays are expressed in ms (or seconds
+ * for the long idle timers), so they don't depend on the clock nor on how
+ * long a frame takes to draw.
+ *
+ * Build configurations:
+ *   default       RC oscillator (RCIO), R/C picked for ~4 MHz
+ *   CLOCK_HSPLL   10 MHz crystal with the x4 PLL, 40 MHz
+ *                 Note: OSC2 takes RA6, MODE1 is read from the left knob
+ *                 at power on instead (see main.c).
+ */
+
+#ifndef TIMER_H
+#define	TIMER_H
+
+#if defined(CLOCK_HSPLL)
+#define FOSC            40000000
+#define TIMER_T0CON     0b10000011  // ON, 16 bit, Fosc/4, 1:16 -> 625 ticks/ms
+#define TIMER_Prescale  16
+#else
+#define FOSC            4000000
+#define TIMER_T0CON     0b10000010  // ON, 16 bit, Fosc/4, 1:8  -> 125 ticks/ms
+#define TIMER_Prescale  8
+#endif
+
+#define TIMER_TicksPerMs  ((unsigned int) (FOSC / 4 / TIMER_Prescale / 1000))
+
+// Seconds elapsed during the last TIMER_update()
+extern unsigned char TIMER_Seconds;
+
+/**
+ * Start Timer0
+ */
+void TIMER_init(void);
+
+/**
+ * Milliseconds elapsed since the previous call (saturates at 255)
+ * Must be called more often than Timer0 wraps: 65536 ticks, ~105 ms at
+ * 40 MHz (~524 ms at 4 MHz). A longer gap loses the whole wrap.
+ */
+unsigned char TIMER_update(void);
+
+/**
+ * Raw Timer0 ticks, for measuring short intervals
+ */
+unsigned int TIMER_ticks(void);
+
+#endif	/* TIMER_H */
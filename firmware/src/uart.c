@@ -0,0 +1,105 @@
+#include <p18cxxx.h>
+#include "timer.h"
+#include "uart.h"
+
+#if defined(UART_Enabled)
+
+#pragma udata
+
+unsigned char UART_TxBuf[UART_TxSize];
+volatile unsigned char UART_TxHead = 0;  // Written by the main loop
+volatile unsigned char UART_TxTail = 0;  // Written by the ISR
+#if defined(UART_RxEnabled)
+unsigned char UART_RxBuf[UART_RxSize];
+volatile unsigned char UART_RxHead = 0;  // Written by the ISR
+volatile unsigned char UART_RxTail = 0;  // Written by the main loop
+unsigned char UART_RxByte;               // ISR scratch
+#endif
+
+void UART_isr(void);
+
+#pragma code high_vector = 0x08
+void UART_vector(void){
+    _asm
+        GOTO UART_isr
+    _endasm
+}
+
+#pragma code
+
+#pragma interrupt UART_isr save = FSR0L, FSR0H
+void UART_isr(void){
+#if defined(UART_RxEnabled)
+    if (PIR1bits.RCIF){
+        if (RCSTAbits.OERR){
+            // Overrun stops the receiver until CREN is toggled
+            RCSTAbits.CREN = 0;
+            RCSTAbits.CREN = 1;
+        }
+        // Reading RCREG clears RCIF, keep the byte if there is room
+        UART_RxByte = RCREG;
+        if (((UART_RxHead + 1) & UART_RxMask) != UART_RxTail){
+            UART_RxBuf[UART_RxHead] = UART_RxByte;
+            UART_RxHead = (UART_RxHead + 1) & UART_RxMask;
+        }
+    }
+#endif
+    if (PIR1bits.TXIF && PIE1bits.TXIE){
+        if (UART_TxTail != UART_TxHead){
+            TXREG = UART_TxBuf[UART_TxTail];
+            UART_TxTail = (UART_TxTail + 1) & UART_TxMask;
+        }
+        else{
+            // Nothing left, the next UART_txPut() turns it back on
+            PIE1bits.TXIE = 0;
+        }
+    }
+}
+
+void UART_init(void){
+    UART_TxHead = 0;
+    UART_TxTail = 0;
+
+    TRISC |= 0b11000000;    // RC6/RC7 as inputs, the USART drives them
+    SPBRG = UART_Spbrg;
+    TXSTA = 0b00100100;     // 8 bit, TXEN, async, BRGH
+#if defined(UART_RxEnabled)
+    UART_RxHead = 0;
+    UART_RxTail = 0;
+    RCSTA = 0b10010000;     // SPEN, CREN
+    PIE1bits.RCIE  = 1;
+#else
+    RCSTA = 0b10000000;     // SPEN
+#endif
+
+    PIE1bits.TXIE  = 0;
+    INTCONbits.PEIE = 1;
+    INTCONbits.GIE  = 1;
+}
+
+unsigned char UART_txFree(void){
+    return (UART_TxTail - UART_TxHead - 1) & UART_TxMask;
+}
+
+void UART_txPut(unsigned char b){
+    UART_TxBuf[UART_TxHead] = b;
+    UART_TxHead = (UART_TxHead + 1) & UART_TxMask;
+    PIE1bits.TXIE = 1;
+}
+
+#if defined(UART_RxEnabled)
+
+unsigned char UART_rxCount(void){
+    return (UART_RxHead - UART_RxTail) & UART_RxMask;
+}
+
+unsigned char UART_rxGet(void){
+    unsigned char b = UART_RxBuf[UART_RxTail];
+
+    UART_RxTail = (UART_RxTail + 1) & UART_RxMask;
+    return b;
+}
+
+#endif
+
+#endif
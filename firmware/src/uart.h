@@ -0,0 +1,61 @@
+/*
+ * File:   uart.h
+ *
+ * Interrupt driven USART
+ * Bytes go into a ring buffer and the TX interrupt feeds TXREG, so the main
+ * loop never waits on the line. When the ring is full nothing is queued.
+ * LINK builds also receive: the RX interrupt fills a second ring, bytes that
+ * don't fit are lost.
+ *
+ * Pin budget: the USART takes RC6/TX and RC7/RX, which are the two top bits
+ * of the horizontal DAC. Builds using it drive the H ladder with 6 bits on
+ * RC0-RC5 (see H_Code in main.c), the ladder has to be wired accordingly.
+ */
+
+#ifndef UART_H
+#define	UART_H
+
+// Builds that need the USART
+#if defined(TELEMETRY) || defined(LINK)
+#define UART_Enabled
+#endif
+#if defined(LINK)
+#define UART_RxEnabled
+#endif
+#if defined(TELEMETRY) && defined(LINK)
+#error "TELEMETRY and LINK both need the USART"
+#endif
+
+#define UART_Baud     19200
+// Ring size, power of 2
+#define UART_TxSize   64
+#define UART_TxMask   (UART_TxSize - 1)
+#define UART_RxSize   64
+#define UART_RxMask   (UART_RxSize - 1)
+
+// BRGH = 1: Fosc / (16 * (SPBRG + 1)), rounded
+#define UART_Spbrg    ((unsigned char) ((FOSC + 8L * UART_Baud) / (16L * UART_Baud) - 1))
+
+void UART_init(void);
+
+/**
+ * Free room in the TX ring
+ */
+unsigned char UART_txFree(void);
+
+/**
+ * Queue one byte, the caller has checked UART_txFree()
+ */
+void UART_txPut(unsigned char b);
+
+/**
+ * Bytes waiting in the RX ring
+ */
+unsigned char UART_rxCount(void);
+
+/**
+ * Take one byte, the caller has checked UART_rxCount()
+ */
+unsigned char UART_rxGet(void);
+
+#endif	/* UART_H */
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+PIC Tennis divergence finder
+
+Runs two gamesim builds (see gamesim.c) on the same session and finds the
+first frame where their game state differs, for instance the float physics
+against PHYS_SEGMENT, or a build before and after a change:
+
+    gamebisect.py [-n frames] [-k K] [-m mode] [-s seed] [-i session.csv] simA simB
+
+Both run the whole session printing the state hash every K frames and
+leaving a snapshot at each of them. Between the last checkpoint that
+matches and the first one that doesn't, both restart from their own
+snapshot with checkpoints 16 times closer, and so on down to single frames.
+Then the state of both after the first divergent frame is printed side by
+side, only the variables that differ.
+"""
+
+import getopt
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+SPLIT = 16
+
+
+def run(sim, opts, start, until, every, prefix):
+    cmd = [sim] + opts + ["-n", str(until), "-k", str(every), "-W", prefix]
+    if start is not None:
+        cmd += ["-r", start]
+    out = subprocess.run(cmd, stdout=subprocess.PIPE, check=True, text=True).stdout
+    hashes = {}
+    for line in out.splitlines():
+        f = line.split()
+        if len(f) == 6 and f[0] == "frame":
+            hashes[int(f[1])] = (int(f[3]), f[5])
+    return hashes
+
+
+def dump(sim, opts, start, until):
+    cmd = [sim] + opts + ["-n", str(until), "-d"]
+    if start is not None:
+        cmd += ["-r", start]
+    out = subprocess.run(cmd, stdout=subprocess.PIPE, check=True, text=True).stdout
+    state = {}
+    for line in out.splitlines()[:-1]:
+        name, _, value = line.partition(" ")
+        state[name] = value
+    return state
+
+
+def main(argv):
+    try:
+        optlist, args = getopt.getopt(argv[1:], "n:k:m:s:i:")
+    except getopt.GetoptError as e:
+        sys.exit("%s\nusage: gamebisect.py [-n frames] [-k K] [-m mode] [-s seed] "
+                 "[-i session.csv] simA simB" % e)
+    if len(args) != 2:
+        sys.exit("usage: gamebisect.py [-n frames] [-k K] [-m mode] [-s seed] "
+                 "[-i session.csv] simA simB")
+    frames, every, opts = 100000, 4096, []
+    for o, v in optlist:
+        if o == "-n":
+            frames = int(v)
+        elif o == "-k":
+            every = max(1, int(v))
+        else:
+            opts += [o, v]
+    sims = [os.path.abspath(a) for a in args]
+
+    tmp = tempfile.mkdtemp(prefix="gamebisect.")
+    try:
+        prefix = [os.path.join(tmp, "a"), os.path.join(tmp, "b")]
+        # Window: last frame known to match (None: power on) and the end
+        lo, hi = None, frames
+        while True:
+            start = [None, None] if lo is None else ["%s.%d" % (p, lo) for p in prefix]
+            runs = [run(sims[i], opts, start[i], hi, every, prefix[i]) for i in (0, 1)]
+            checks = sorted(set(runs[0]) | set(runs[1]))
+            bad = None
+            for f in checks:
+                if runs[0].get(f) != runs[1].get(f):
+                    bad = f
+                    break
+                lo = f
+            if bad is None:
+                print("no divergence in %d frames" % (checks[-1] if checks else 0))
+                return 0
+            hi = bad
+            print("frames %s-%d: diverged, checkpoints every %d"
+                  % (0 if lo is None else lo, hi, every))
+            if every == 1:
+                break
+            every = max(1, every // SPLIT)
+
+        start = [None, None] if lo is None else ["%s.%d" % (p, lo) for p in prefix]
+        print("first divergent frame: %d (steps %s / %s)"
+              % (hi, runs[0][hi][0] if hi in runs[0] else "?",
+                 runs[1][hi][0] if hi in runs[1] else "?"))
+        state = [dump(sims[i], opts, start[i], hi) for i in (0, 1)]
+        width = max(len(n) for n in state[0])
+        for name in state[0]:
+            if name in state[1] and state[0][name] != state[1][name]:
+                print("  %-*s  %s  |  %s" % (width, name, state[0][name], state[1][name]))
+        return 1
+    finally:
+        shutil.rmtree(tmp)
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,790 @@
+/*
+ * PIC Tennis game simulator
+ *
+ * Runs the game of firmware/src/main.c on Linux, as fast as it goes: the
+ * host calls GAME_frame() (mode switches, idle timers, knobs, game steps)
+ * and skips the drawing, the DAC routines do nothing. The C18 device
+ * headers are replaced by tools/host/.
+ *
+ *   cc -O2 -Wno-unknown-pragmas -Ihost -I../firmware/src -o gamesim gamesim.c -lm
+ *   ./gamesim [-m mode] [-s seed] [-i session.csv] [-r snap] [-n frame]
+ *             [-u pred] [-k K] [-W prefix] [-w snap] [-d] [-e eeprom.bin]
+ *             [-l frame[,player]]
+ *
+ *   -m  mode switches, 0-3 (0: auto)
+ *   -s  seed, stands for the knob reading GAME_rand() is seeded with, and
+ *       seeds the simulated players (1)
+ *   -i  replay the knobs, buttons and frame times of a session recorded by
+ *       a TELEMETRY build (telem2csv.py output) instead of random players.
+ *       A record covers a few frames (its frames column): they are run
+ *       with its knobs and buttons and share its ms
+ *   -r  restore a snapshot first
+ *   -n  run until this frame (frames are counted from power on) (3000)
+ *   -u  or until: steps=N, balls=N (balls served), dead (dead ball) or
+ *       mode=N (mode entered, e.g. the idle fallback)
+ *   -k  print the state hash every K frames
+ *   -W  with -k, also write a snapshot to prefix.<frame> every K frames
+ *   -w  write a snapshot at the end
+ *   -d  dump the game state at the end, one variable per line
+ *   -e  data EEPROM image (256 bytes) the board boots with, for the court
+ *       and the tune. Blank otherwise
+ *   -l  input to output latency of an injected edge: the button of player
+ *       (0: left, 1: right) goes down at this frame and is held for
+ *       LAT_Window frames, then the run carries on with the usual inputs
+ *
+ * The last line is always "frame F steps S hash H". The hash covers the
+ * game state every build has (not the trails, the court, the tune, the
+ * state a build option adds nor xp, yp, which BALL_SUBPIXEL places finer)
+ * so two builds of the same game can be compared, gamebisect.py finds the
+ * first frame where they part.
+ *
+ * Snapshot, host byte order (only for the machine that wrote it):
+ *   "GSNP" version(2)
+ *   records: id(2) size(2) data(size), until id 0
+ * Each record is one variable, copied as it is in RAM. Loading skips ids it
+ * doesn't know and records whose size doesn't match the build, what they
+ * hold keeps its power on value: a PHYS_SEGMENT build restoring a snapshot
+ * of a float build starts a new flight segment from the float state.
+ *
+ * With -l the run forks at the press: one copy runs the frames as they
+ * were, the other with the button held, and the first frame whose output
+ * differs (where each ball's trail ends, the ball waiting to be served) is
+ * reported in frames, game steps and ms after the press:
+ *   "latency: player P pressed at frame N, output at frame F (+f frames,
+ *    s steps, t ms)", or "no output change in W frames"
+ * The button only acts where the rules let it (the ball on the player's
+ * side, not used yet), so pick N with the ball in reach, -u and -d help.
+ *
+ * Not for LINK, TELEMETRY or PROFILE builds, they need the USART and the
+ * timer.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "board.c"
+
+#define SNAP_Magic     "GSNP"
+#define SNAP_Version   1
+#define SESSION_Max    (1L << 22)
+#define SESSION_Cols   6
+
+/* Players: random, or replayed from a session */
+
+typedef struct
+{
+    unsigned char knob[2];    // 0-127
+    unsigned char btn[2];     // Pin level, 0: pressed
+    unsigned char ms;
+} INPUT;
+
+static unsigned long  frame, steps;
+static unsigned long  rnd_state = 1;
+static unsigned char  rnd_knob[2] = { 64, 64 };
+static unsigned char  mode_pins;
+static INPUT         *session;
+static unsigned long  session_n;
+static int            done;
+static int            lat_held = -1;   // Player whose button -l holds down, -1: none
+
+static unsigned long rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    rnd_state &= 0xffffffffUL;
+    return rnd_state;
+}
+
+// Knobs wander, buttons now and then, a frame takes 12 to 20 ms to draw
+static void input_random(INPUT *in)
+{
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        rnd_knob[i] = (rnd_knob[i] + rnd() % 5 - 2) & 0x7f;
+        in->knob[i] = rnd_knob[i];
+        in->btn[i]  = rnd() % 16 != 0;
+    }
+    in->ms = 12 + rnd() % 9;
+}
+
+static void input_pins(const INPUT *in)
+{
+    PORTAbits.RA2 = lat_held == 0 ? 0 : in->btn[0];
+    PORTAbits.RA4 = lat_held == 1 ? 0 : in->btn[1];
+    PORTAbits.RA5 = mode_pins >> 1;
+#if defined(CLOCK_HSPLL)
+    nModeKnob     = mode_pins & 1;
+#else
+    PORTAbits.RA6 = mode_pins & 1;
+#endif
+}
+
+/*
+ * POWER_idle(): one watchdog wake up. Timer0 is stopped while asleep, so
+ * no time passes for the game. A session has no records while the board
+ * sleeps, the next one is what woke it up.
+ */
+void HOST_sleep(void)
+{
+    INPUT in;
+
+    if (session) {
+        if (frame < session_n) {
+            in = session[frame];
+        }
+        else {
+            done = 1;
+            in.btn[0] = 0;
+            in.btn[1] = 1;
+        }
+        if (in.btn[0] && in.btn[1]) {
+            // Woken by something the record doesn't show
+            in.btn[0] = 0;
+        }
+    }
+    else {
+        input_random(&in);
+    }
+    input_pins(&in);
+}
+
+static void sim_frame(void)
+{
+    INPUT         in;
+    unsigned char nClock = nTrailClock;
+
+    if (session) {
+        if (frame >= session_n) {
+            done = 1;
+            return;
+        }
+        in = session[frame];
+    }
+    else {
+        input_random(&in);
+    }
+    input_pins(&in);
+    knob[0]  = in.knob[0];
+    knob[1]  = in.knob[1];
+    frame_ms = in.ms;
+
+    // and the tasks the main loop would run while drawing
+    GAME_frame();
+    TASK_flush();
+
+    frame++;
+    steps += (unsigned char) (nTrailClock - nClock);
+}
+
+/* telem2csv.py output: frame times, knobs and buttons */
+
+// Points field[i] at column col[i] of a CSV line, the commas become NULs
+static void session_fields(char *line, const int *col, char **field)
+{
+    int   c, i;
+    char *p = line;
+
+    for (c = 0; p; c++) {
+        for (i = 0; i < SESSION_Cols; i++) {
+            if (col[i] == c) {
+                field[i] = p;
+            }
+        }
+        p = strchr(p, ',');
+        if (p) {
+            *p++ = 0;
+        }
+    }
+}
+
+static int session_load(const char *path)
+{
+    // frames last: older sessions have one frame a record and no column
+    static const char *name[SESSION_Cols] = { "l_angle", "r_angle", "l_btn", "r_btn", "frame_ms", "frames" };
+    FILE  *f;
+    char   line[1024], *field[SESSION_Cols], *p;
+    int    col[SESSION_Cols], i;
+    long   v[SESSION_Cols], r;
+
+    f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    if (!fgets(line, sizeof line, f)) {
+        fprintf(stderr, "%s: empty\n", path);
+        fclose(f);
+        return -1;
+    }
+    line[strcspn(line, "\r\n")] = 0;
+    // Header: find the columns by name
+    for (i = 0; i < SESSION_Cols; i++) {
+        col[i] = -1;
+    }
+    for (i = 0, p = line; p; i++) {
+        char *end = strchr(p, ',');
+        int   n;
+
+        if (end) {
+            *end = 0;
+        }
+        for (n = 0; n < SESSION_Cols; n++) {
+            if (strcmp(p, name[n]) == 0) {
+                col[n] = i;
+            }
+        }
+        p = end ? end + 1 : NULL;
+    }
+    for (i = 0; i < 5; i++) {
+        if (col[i] < 0) {
+            fprintf(stderr, "%s: no %s column\n", path, name[i]);
+            fclose(f);
+            return -1;
+        }
+    }
+
+    session = malloc(SESSION_Max * sizeof *session);
+    if (!session) {
+        perror("malloc");
+        exit(1);
+    }
+    while (session_n < SESSION_Max && fgets(line, sizeof line, f)) {
+        line[strcspn(line, "\r\n")] = 0;
+        for (i = 0; i < 5; i++) {
+            field[i] = "0";
+        }
+        field[5] = "1";
+        session_fields(line, col, field);
+        for (i = 0; i < SESSION_Cols; i++) {
+            v[i] = strtol(field[i], NULL, 10);
+        }
+        if (v[4] < 0) {
+            v[4] = 0;
+        }
+        if (v[5] < 1) {
+            v[5] = 1;
+        }
+        // The record's frames share its ms, the first ones take the remainder
+        for (r = 0; r < v[5] && session_n < SESSION_Max; r++) {
+            long ms = v[4] / v[5] + (r < v[4] % v[5]);
+
+            session[session_n].knob[0] = v[0] & 0x7f;
+            session[session_n].knob[1] = v[1] & 0x7f;
+            session[session_n].btn[0]  = v[2] != 0;
+            session[session_n].btn[1]  = v[3] != 0;
+            session[session_n].ms      = ms > 255 ? 255 : (unsigned char) ms;
+            session_n++;
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+/* Snapshot */
+
+#define SNAP_Hash  1        // In the state hash
+
+typedef struct
+{
+    unsigned short id;
+    const char    *name;
+    void          *p;
+    unsigned short size;
+    unsigned short count;   // Elements
+    char           kind;    // Dumped as: b bytes, f floats, u unsigned
+    unsigned char  flags;
+} SNAP_VAR;
+
+#define SNAP(id, v, kind, n, flags)  { id, #v, (void *) &v, sizeof v, n, kind, flags }
+
+static SNAP_VAR snap_vars[] = {
+    // Game
+    SNAP(1,  Game,          'b', 1,        SNAP_Hash),
+    SNAP(2,  iDelayNewBall, 'u', 1,        SNAP_Hash),
+    SNAP(3,  iTimerIdle,    'u', 1,        SNAP_Hash),
+    SNAP(4,  iPhysAcc,      'u', 1,        SNAP_Hash),
+    SNAP(5,  nElapsed,      'u', 1,        SNAP_Hash),
+    SNAP(6,  xp,            'u', 1,        0),
+    SNAP(7,  yp,            'u', 1,        0),
+    SNAP(8,  nModeSel,      'u', 1,        SNAP_Hash),
+    SNAP(9,  xOld,          'f', 1,        SNAP_Hash),
+    SNAP(10, yOld,          'f', 1,        SNAP_Hash),
+    SNAP(11, xNew,          'f', 1,        SNAP_Hash),
+    SNAP(12, yNew,          'f', 1,        SNAP_Hash),
+    SNAP(13, VxOld,         'f', 1,        SNAP_Hash),
+    SNAP(14, VyOld,         'f', 1,        SNAP_Hash),
+    SNAP(15, VxNew,         'f', 1,        SNAP_Hash),
+    SNAP(16, VyNew,         'f', 1,        SNAP_Hash),
+    SNAP(17, nBalls,        'u', 1,        SNAP_Hash),
+    SNAP(18, nFrames,       'u', 1,        SNAP_Hash),
+    SNAP(19, nStressSec,    'u', 1,        SNAP_Hash),
+    SNAP(20, nFps,          'u', BALL_Max, SNAP_Hash),
+    SNAP(21, nBallCount,    'u', 1,        SNAP_Hash),
+    SNAP(22, nTrailClock,   'u', 1,        SNAP_Hash),
+    SNAP(23, iRandState,    'u', 1,        SNAP_Hash),
+    SNAP(24, Ball_x,        'f', BALL_Max, SNAP_Hash),
+    SNAP(25, Ball_y,        'f', BALL_Max, SNAP_Hash),
+    SNAP(26, Ball_Vx,       'f', BALL_Max, SNAP_Hash),
+    SNAP(27, Ball_Vy,       'f', BALL_Max, SNAP_Hash),
+    SNAP(28, Ball_Hits,     'u', BALL_Max, SNAP_Hash),
+    SNAP(29, Trails,        'b', 1,        0),
+    SNAP(30, iVal,          'u', 1,        0),
+    SNAP(31, Court,         'b', 1,        0),
+    SNAP(32, Tune,          'b', 1,        0),
+    SNAP(33, nTuneSel,      'u', 1,        0),
+    // Build options
+#if defined(BALL_SUBPIXEL)
+    SNAP(40, Ball_Sub,      'u', BALL_Max, 0),
+#endif
+#if defined(PHYS_SEGMENT)
+    SNAP(41, Segs,          'b', 1,        0),
+    SNAP(42, Seg,           'b', 1,        0),
+    SNAP(43, iPhysClock,    'u', 1,        0),
+#endif
+#if defined(RALLY)
+    SNAP(44, iRally,        'u', 1,        0),
+    SNAP(45, iRallyX,       'u', 1,        0),
+    SNAP(46, iRallyY,       'u', 1,        0),
+    SNAP(47, iRallyVx,      'u', 1,        0),
+    SNAP(48, iRallyVy,      'u', 1,        0),
+    SNAP(49, nRallyLeft,    'u', 1,        0),
+    SNAP(50, nRallyWait,    'u', 1,        0),
+#endif
+    // Host
+    SNAP(100, frame,        'u', 1,        0),
+    SNAP(101, steps,        'u', 1,        0),
+    SNAP(102, rnd_state,    'u', 1,        0),
+    SNAP(103, rnd_knob,     'u', 2,        0),
+    SNAP(104, timer_ms,     'u', 1,        0),
+    SNAP(105, timer_ticks,  'u', 1,        0),
+    SNAP(106, ADCON0bits,   'b', 1,        0),
+};
+
+#define SNAP_Vars  (sizeof snap_vars / sizeof snap_vars[0])
+
+static int put16(FILE *f, unsigned short v)
+{
+    return fwrite(&v, sizeof v, 1, f) == 1 ? 0 : -1;
+}
+
+static int get16(FILE *f, unsigned short *v)
+{
+    return fread(v, sizeof *v, 1, f) == 1 ? 0 : -1;
+}
+
+int snap_save(const char *path)
+{
+    FILE    *f;
+    unsigned i;
+    int      err = 0;
+
+    f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    err |= fwrite(SNAP_Magic, 4, 1, f) != 1;
+    err |= put16(f, SNAP_Version);
+    for (i = 0; i < SNAP_Vars; i++) {
+        err |= put16(f, snap_vars[i].id);
+        err |= put16(f, snap_vars[i].size);
+        err |= fwrite(snap_vars[i].p, snap_vars[i].size, 1, f) != 1;
+    }
+    err |= put16(f, 0);
+    err |= put16(f, 0);
+    err |= fclose(f) != 0;
+    if (err) {
+        fprintf(stderr, "%s: write error\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int snap_load(const char *path)
+{
+    FILE          *f;
+    char           magic[4];
+    unsigned short version, id, size;
+    unsigned       i;
+
+    f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    if (fread(magic, 4, 1, f) != 1 || memcmp(magic, SNAP_Magic, 4)
+        || get16(f, &version) || version != SNAP_Version) {
+        fprintf(stderr, "%s: not a version %d snapshot\n", path, SNAP_Version);
+        fclose(f);
+        return -1;
+    }
+    for (;;) {
+        if (get16(f, &id) || get16(f, &size)) {
+            fprintf(stderr, "%s: truncated\n", path);
+            fclose(f);
+            return -1;
+        }
+        if (id == 0) {
+            break;
+        }
+        for (i = 0; i < SNAP_Vars; i++) {
+            if (snap_vars[i].id == id && snap_vars[i].size == size) {
+                break;
+            }
+        }
+        if (i < SNAP_Vars) {
+            if (fread(snap_vars[i].p, size, 1, f) != 1) {
+                fprintf(stderr, "%s: truncated\n", path);
+                fclose(f);
+                return -1;
+            }
+        }
+        else if (fseek(f, size, SEEK_CUR)) {
+            perror(path);
+            fclose(f);
+            return -1;
+        }
+    }
+    fclose(f);
+
+    // The mode copy holds function pointers, it comes from the table
+    if (nMode < MODE_Count) {
+        Mode = MODE_Table[nMode];
+    }
+    // and the tuning menu lets the ball play itself, MODE_frameDebug()
+    if (nTune) {
+        Mode.Hit[0] = HIT_auto;
+        Mode.Hit[1] = HIT_auto;
+    }
+    COURT_build();
+    return 0;
+}
+
+// FNV-1a over the SNAP_Hash variables
+static unsigned long long snap_hash(void)
+{
+    unsigned long long   h = 14695981039346656037ULL;
+    const unsigned char *p;
+    unsigned             i, n;
+
+    for (i = 0; i < SNAP_Vars; i++) {
+        if (!(snap_vars[i].flags & SNAP_Hash)) {
+            continue;
+        }
+        p = snap_vars[i].p;
+        for (n = 0; n < snap_vars[i].size; n++) {
+            h = (h ^ p[n]) * 1099511628211ULL;
+        }
+    }
+    return h;
+}
+
+static void snap_dump(void)
+{
+    const unsigned char *p;
+    unsigned             i, n, w;
+    unsigned long        v;
+    float                fv;
+
+    printf("Game.Flags Debug %u Auto_L %u Auto_R %u SingleHit %u DeadBallRule %u"
+           " Side %u DeadBall %u L_Used %u R_Used %u CourtDirty %u Rally %u Tune %u TuneArm %u"
+           " TuneSet %u\n",
+           Game.Debug, Game.Mode_Auto_L, Game.Mode_Auto_R, Game.Rule_SingleHit,
+           Game.Rule_DeadBall, Game.Side, Game.DeadBall, Game.L_Used, Game.R_Used,
+           Game.CourtDirty, Game.Rally, Game.Tune, Game.TuneArm, Game.TuneSet);
+    printf("Game.Mode %u\nGame.BallHits %u\nGame.L_Angle %u\nGame.R_Angle %u\n",
+           Game.Mode, Game.BallHits, Game.L_Angle, Game.R_Angle);
+
+    for (i = 0; i < SNAP_Vars; i++) {
+        p = snap_vars[i].p;
+        switch (snap_vars[i].kind) {
+        case 'f':
+            for (n = 0; n < snap_vars[i].count; n++) {
+                memcpy(&fv, p + n * sizeof fv, sizeof fv);
+                if (snap_vars[i].count == 1) {
+                    printf("%s %.9g\n", snap_vars[i].name, fv);
+                }
+                else {
+                    printf("%s[%u] %.9g\n", snap_vars[i].name, n, fv);
+                }
+            }
+            break;
+        case 'u':
+            w = snap_vars[i].size / snap_vars[i].count;
+            for (n = 0; n < snap_vars[i].count; n++) {
+                v = 0;
+                memcpy(&v, p + n * w, w);
+                if (snap_vars[i].count == 1) {
+                    printf("%s %lu\n", snap_vars[i].name, v);
+                }
+                else {
+                    printf("%s[%u] %lu\n", snap_vars[i].name, n, v);
+                }
+            }
+            break;
+        case 'b':
+            printf("%s", snap_vars[i].name);
+            for (n = 0; n < snap_vars[i].size; n++) {
+                printf("%s%02x", n % 16 ? "" : " ", p[n]);
+            }
+            printf("\n");
+            break;
+        }
+    }
+}
+
+/* Run until */
+
+enum { UNTIL_None, UNTIL_Steps, UNTIL_Balls, UNTIL_Dead, UNTIL_Mode };
+
+static int until_kind = UNTIL_None;
+static unsigned long until_n;
+
+static int until_parse(const char *s)
+{
+    if (strncmp(s, "steps=", 6) == 0) {
+        until_kind = UNTIL_Steps;
+    }
+    else if (strncmp(s, "balls=", 6) == 0) {
+        until_kind = UNTIL_Balls;
+    }
+    else if (strncmp(s, "mode=", 5) == 0) {
+        until_kind = UNTIL_Mode;
+    }
+    else if (strcmp(s, "dead") == 0) {
+        until_kind = UNTIL_Dead;
+        return 0;
+    }
+    else {
+        return -1;
+    }
+    until_n = strtoul(strchr(s, '=') + 1, NULL, 10);
+    return 0;
+}
+
+static int until_met(void)
+{
+    switch (until_kind) {
+    case UNTIL_Steps: return steps >= until_n;
+    case UNTIL_Balls: return nBallCount >= until_n;
+    case UNTIL_Dead:  return nDeadBall;
+    case UNTIL_Mode:  return nMode == until_n;
+    }
+    return 0;
+}
+
+/* Injected edge latency */
+
+#define LAT_Window  64      // Frames compared after the press
+
+static long               lat_frame = -1;  // -l: press at this frame
+static int                lat_player;
+static int                lat_fd    = -1;  // Pipe, write end in the copy without the press
+static pid_t              lat_pid;         // 0 in that copy
+static int                lat_n;           // Frames recorded since the press
+static unsigned long long lat_out[LAT_Window];
+static unsigned long      lat_steps[LAT_Window];
+static unsigned long      lat_ms[LAT_Window];
+
+// FNV-1a over what the frame puts on the scope
+static unsigned long long frame_out(void)
+{
+    unsigned long long h = 0xcbf29ce484222325ULL;
+    unsigned char      out[2 * BALL_Max + 3];
+    unsigned           i, n = 0;
+
+    out[n++] = nBalls;
+    for (i = 0; i < nBalls; i++) {
+        out[n++] = Trails[i].x[TRAIL_Head(i)];
+        out[n++] = Trails[i].y[TRAIL_Head(i)];
+    }
+    if (iDelayNewBall > 0) {
+        out[n++] = xp;
+        out[n++] = yp;
+    }
+    for (i = 0; i < n; i++) {
+        h = (h ^ out[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static int lat_start(void)
+{
+    int fd[2];
+
+    if (pipe(fd)) {
+        perror("pipe");
+        return -1;
+    }
+    fflush(stdout);
+    lat_pid = fork();
+    if (lat_pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    if (lat_pid == 0) {
+        close(fd[0]);
+        lat_fd = fd[1];
+    }
+    else {
+        close(fd[1]);
+        lat_fd   = fd[0];
+        lat_held = lat_player;
+    }
+    lat_n = 0;
+    return 0;
+}
+
+static void lat_record(void)
+{
+    lat_out[lat_n]   = frame_out();
+    lat_steps[lat_n] = steps;
+    lat_ms[lat_n]    = (lat_n ? lat_ms[lat_n - 1] : 0) + frame_ms;
+    lat_n++;
+}
+
+// The copy without the press hands its frames over and ends, the other
+// one compares and carries on
+static void lat_end(unsigned long steps0)
+{
+    unsigned long long base[LAT_Window];
+    ssize_t            got;
+    size_t             len = 0;
+    int                i, n;
+
+    if (lat_pid == 0) {
+        got = write(lat_fd, lat_out, lat_n * sizeof lat_out[0]);
+        _exit(got == (ssize_t) (lat_n * sizeof lat_out[0]) ? 0 : 1);
+    }
+    while ((got = read(lat_fd, (char *) base + len, sizeof base - len)) > 0) {
+        len += got;
+    }
+    close(lat_fd);
+    waitpid(lat_pid, NULL, 0);
+    lat_fd   = -1;
+    lat_held = -1;
+
+    n = (int) (len / sizeof base[0]);
+    n = n < lat_n ? n : lat_n;
+    for (i = 0; i < n && base[i] == lat_out[i]; i++) {
+    }
+    if (i < n) {
+        printf("latency: player %d pressed at frame %ld, output at frame %ld (+%d frames,"
+               " %lu steps, %lu ms)\n", lat_player, lat_frame, lat_frame + i, i,
+               lat_steps[i] - steps0, lat_ms[i]);
+    }
+    else {
+        printf("latency: player %d pressed at frame %ld, no output change in %d frames\n",
+               lat_player, lat_frame, n);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int           opt, dump = 0;
+    unsigned long seed = 1, target = 3000, every = 0;
+    const char   *in_snap = NULL, *out_snap = NULL, *prefix = NULL, *csv = NULL;
+    unsigned long lat_steps0 = 0;
+    FILE         *f;
+    char          name[4096];
+    char         *end;
+
+    memset(eeprom, 0xff, sizeof eeprom);
+    while ((opt = getopt(argc, argv, "m:s:i:r:n:u:k:W:w:de:l:")) != -1) {
+        switch (opt) {
+        case 'm': mode_pins = atoi(optarg) & 3; break;
+        case 's': seed      = strtoul(optarg, NULL, 0); break;
+        case 'i': csv       = optarg; break;
+        case 'r': in_snap   = optarg; break;
+        case 'n': target    = strtoul(optarg, NULL, 0); break;
+        case 'k': every     = strtoul(optarg, NULL, 0); break;
+        case 'W': prefix    = optarg; break;
+        case 'w': out_snap  = optarg; break;
+        case 'd': dump      = 1; break;
+        case 'e':
+            f = fopen(optarg, "rb");
+            if (!f || fread(eeprom, 1, sizeof eeprom, f) != sizeof eeprom) {
+                fprintf(stderr, "%s: can't read 256 bytes\n", optarg);
+                return 1;
+            }
+            fclose(f);
+            break;
+        case 'l':
+            lat_frame  = strtol(optarg, &end, 0);
+            lat_player = *end == ',' ? atoi(end + 1) & 1 : 0;
+            break;
+        case 'u':
+            if (until_parse(optarg) == 0) {
+                break;
+            }
+            /* fall through */
+        default:
+            fprintf(stderr, "usage: %s [-m mode] [-s seed] [-i session.csv] [-r snap] [-n frame]\n"
+                            "       [-u steps=N|balls=N|mode=N|dead] [-k K] [-W prefix] [-w snap] [-d]\n"
+                            "       [-e eeprom.bin] [-l frame[,player]]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (csv && session_load(csv)) {
+        return 1;
+    }
+
+    // Power on, the seed stands for the knob reading
+    GAME_init((word) seed);
+    rnd_state = (seed * 2654435761UL ^ 0x9e3779b9UL) & 0xffffffffUL;
+    if (!rnd_state) {
+        rnd_state = 1;
+    }
+    if (in_snap && snap_load(in_snap)) {
+        return 1;
+    }
+
+    while (frame < target && !done) {
+        if (lat_frame >= 0 && frame == (unsigned long) lat_frame) {
+            lat_steps0 = steps;
+            if (lat_start()) {
+                return 1;
+            }
+        }
+        sim_frame();
+        if (lat_fd >= 0) {
+            lat_record();
+            if (lat_n == LAT_Window || done) {
+                lat_end(lat_steps0);
+            }
+        }
+        // The copy without the press keeps quiet, it's only there to compare
+        if (every && frame % every == 0 && !(lat_fd >= 0 && lat_pid == 0)) {
+            printf("frame %lu steps %lu hash %016llx\n", frame, steps, snap_hash());
+            if (prefix) {
+                snprintf(name, sizeof name, "%s.%lu", prefix, frame);
+                if (snap_save(name)) {
+                    return 1;
+                }
+            }
+        }
+        if (until_met()) {
+            break;
+        }
+    }
+
+    if (lat_fd >= 0) {
+        lat_end(lat_steps0);
+    }
+    if (out_snap && snap_save(out_snap)) {
+        return 1;
+    }
+    if (dump) {
+        snap_dump();
+    }
+    printf("frame %lu steps %lu hash %016llx\n", frame, steps, snap_hash());
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * The game of firmware/src/main.c on the host
+ *
+ * Builds main.c and sintable.c for the tools that run the game without a
+ * board (trajgold.c, gamesim.c, rallygen.c): PIC type sizes, main()
+ * renamed out of the way, DAC routines that do nothing, the data EEPROM in
+ * an array, knobs the ADC converts from an array and a timer that counts
+ * whatever frame_ms says. Include it in the one translation unit of the
+ * tool with tools/host/ on the include path, the tool defines HOST_sleep()
+ * for the idle sleep.
+ */
+
+#if defined(LINK) || defined(TELEMETRY) || defined(PROFILE)
+#error "the host game can't run LINK, TELEMETRY or PROFILE builds"
+#endif
+
+// PIC type sizes instead of typedefs.h: word is 16 bits and GAME_rand()
+// relies on it
+#define TYPEDEFS_H
+typedef unsigned char  byte;
+typedef unsigned short word;
+
+#define main fw_main
+#include "main.c"
+#undef main
+#include "sintable.c"
+#include "task.c"
+#if defined(RALLY)
+#include "rally.c"
+#endif
+
+/* No scope */
+
+void DAC_dwell(unsigned char px, unsigned char py, unsigned char n)
+{
+}
+
+void DAC_dwellSub(unsigned char px, unsigned char py, unsigned char nSub)
+{
+}
+
+unsigned char DAC_runX(unsigned char pos, unsigned char n, signed char step)
+{
+    return (unsigned char) (pos + n * step);
+}
+
+unsigned char DAC_runY(unsigned char pos, unsigned char n, signed char step)
+{
+    return (unsigned char) (pos + n * step);
+}
+
+void DAC_points(unsigned char *pList, unsigned char n, unsigned char nStride, unsigned char nDwell)
+{
+}
+
+void DAC_line(unsigned char x0, unsigned char y0, unsigned char x1, unsigned char y1)
+{
+}
+
+/* Data EEPROM */
+
+static unsigned char eeprom[256];
+
+unsigned char EE_read(unsigned char nAddr)
+{
+    return eeprom[nAddr];
+}
+
+void EE_readBlock(unsigned char nAddr, unsigned char *pDst, unsigned char n)
+{
+    while (n--) {
+        *pDst++ = eeprom[nAddr++];
+    }
+}
+
+void EE_write(unsigned char nAddr, unsigned char nData)
+{
+    eeprom[nAddr] = nData;
+}
+
+/* Knobs, 0-127 */
+
+static unsigned char knob[2];
+
+unsigned int HOST_adc(void)
+{
+    unsigned char nChannel = ADCON0bits.CHS0 | ADCON0bits.CHS1 << 1 | ADCON0bits.CHS2 << 2;
+
+    // Left aligned, the game keeps the top 7 bits
+    return (unsigned) knob[nChannel == L_ADC ? 0 : 1] << 9;
+}
+
+/* Timer: every frame takes the ms the input says */
+
+unsigned char TIMER_Seconds;
+
+static unsigned      timer_ms;        // ms into the current second
+static unsigned      timer_ticks;
+static unsigned char frame_ms;        // Length of the frame being run
+
+void TIMER_init(void)
+{
+}
+
+unsigned char TIMER_update(void)
+{
+    timer_ms     += frame_ms;
+    timer_ticks  += frame_ms * TIMER_TicksPerMs;
+    TIMER_Seconds = 0;
+    while (timer_ms >= 1000) {
+        timer_ms -= 1000;
+        TIMER_Seconds++;
+    }
+    return frame_ms;
+}
+
+unsigned int TIMER_ticks(void)
+{
+    return (word) timer_ticks;
+}
@@ -0,0 +1,72 @@
+/*
+ * Host stand-in for the C18 device headers
+ *
+ * Lets the host tools build firmware/src/main.c with a host compiler. The
+ * SFRs main.c touches are plain variables, the tool plays the pins and the
+ * ADC through them. They are defined here, not declared: only one
+ * translation unit may include this file.
+ *
+ * The ADC converts instantly (NOT_DONE stays 0), reading ADRES calls
+ * HOST_adc() for the channel selected, and Sleep() calls HOST_sleep(),
+ * which the tool provides to move time on until something wakes the board.
+ */
+
+#ifndef HOST_P18CXXX_H
+#define HOST_P18CXXX_H
+
+// C18 qualifiers
+#define rom
+#define near
+#define far
+
+void HOST_sleep(void);
+unsigned int HOST_adc(void);
+
+#define Nop()
+#define ClrWdt()
+#define Sleep()     HOST_sleep()
+
+typedef struct
+{
+    unsigned RA0:1, RA1:1, RA2:1, RA3:1, RA4:1, RA5:1, RA6:1;
+} PORTAbits_t;
+
+typedef struct
+{
+    unsigned LATA0:1, LATA1:1, LATA2:1, LATA3:1, LATA4:1, LATA5:1, LATA6:1;
+} LATAbits_t;
+
+typedef struct
+{
+    unsigned TRISA0:1, TRISA1:1, TRISA2:1, TRISA3:1, TRISA4:1, TRISA5:1, TRISA6:1;
+} TRISAbits_t;
+
+typedef struct
+{
+    unsigned ADON:1, NOT_DONE:1, GO:1, CHS0:1, CHS1:1, CHS2:1, ADCS0:1, ADCS1:1;
+} ADCON0bits_t;
+
+typedef struct
+{
+    unsigned PCFG0:1, PCFG1:1, PCFG2:1, PCFG3:1, ADFM:1;
+} ADCON1bits_t;
+
+typedef struct
+{
+    unsigned SWDTEN:1;
+} WDTCONbits_t;
+
+volatile PORTAbits_t   PORTAbits;
+volatile LATAbits_t    LATAbits;
+volatile TRISAbits_t   TRISAbits;
+volatile ADCON0bits_t  ADCON0bits;
+volatile ADCON1bits_t  ADCON1bits;
+volatile WDTCONbits_t  WDTCONbits;
+
+volatile unsigned char PORTA, PORTB, PORTC;
+volatile unsigned char LATB, LATC;
+volatile unsigned char TRISB, TRISC;
+volatile unsigned char ADCON1;
+#define ADRES  HOST_adc()
+
+#endif /* HOST_P18CXXX_H */
@@ -0,0 +1,5 @@
+/*
+ * Host stand-in, see p18cxxx.h
+ */
+
+#include "p18cxxx.h"
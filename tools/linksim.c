@@ -0,0 +1,339 @@
+/*
+ * PIC Tennis link simulator
+ *
+ * Runs firmware/src/link.c on Linux: two processes (one per board) talk
+ * over a socketpair that stands for the serial line, with the USART replaced
+ * by a model of the 19200 baud wire. The game is replaced by a hash of the
+ * inputs, enough to see both boards run the same steps with the same inputs.
+ *
+ *   cc -DLINK -Wno-unknown-pragmas -I../firmware/src -o linksim linksim.c
+ *   ./linksim [-t s] [-l ms] [-j ms] [-p loss] [-d step] [-c]
+ *
+ *   -t  run time, s (10)
+ *   -l  line latency, ms (5)
+ *   -j  extra random latency, ms (0)
+ *   -p  bytes lost, per thousand (0)
+ *   -d  board 0 corrupts its game at this step, to see the desync check (off)
+ *   -c  board 1 has other game settings (LINK_Config), the boards must
+ *       refuse to pair
+ *
+ * Each board prints its link stats, then the game hashes the two boards
+ * logged every 50 steps are compared.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// PIC type sizes instead of typedefs.h: word is 16 bits and link.c relies
+// on step numbers wrapping there
+#define TYPEDEFS_H
+typedef unsigned char  byte;
+typedef unsigned short word;
+
+#include "link.c"
+
+#define BYTE_US     521         // 10 bits at 19200 baud
+#define WIRE_MAX    4096
+#define LOG_MAX     4096
+#define LOG_EVERY   50
+
+static long long now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+/* Wire model, bytes leave the UART at line rate and arrive latency later */
+
+static int       sock;
+static int       lat_us, jitter_us, loss;
+static int       other_config;            // -c
+static unsigned char wire_b[WIRE_MAX];
+static long long wire_out[WIRE_MAX];     // Time the byte leaves the UART
+static long long wire_in[WIRE_MAX];      // Time it reaches the peer
+static unsigned  wire_head, wire_tail;
+static long long wire_last_out, wire_last_in;
+
+static unsigned char rx_buf[UART_RxSize];
+static unsigned char rx_head, rx_tail;
+
+void UART_init(void)
+{
+    wire_head = wire_tail = 0;
+    rx_head = rx_tail = 0;
+}
+
+unsigned char UART_txFree(void)
+{
+    long long t = now_us();
+    unsigned  i, used = 0;
+
+    for (i = wire_tail; i != wire_head; i = (i + 1) % WIRE_MAX) {
+        if (wire_out[i] > t) {
+            used++;
+        }
+    }
+    return used >= UART_TxSize - 1 ? 0 : UART_TxSize - 1 - used;
+}
+
+void UART_txPut(unsigned char b)
+{
+    long long t = now_us();
+
+    wire_last_out = (wire_last_out > t ? wire_last_out : t) + BYTE_US;
+    t = wire_last_out + lat_us + (jitter_us ? rand() % jitter_us : 0);
+    // The line doesn't reorder
+    wire_last_in = t > wire_last_in ? t : wire_last_in;
+
+    wire_b[wire_head]   = b;
+    wire_out[wire_head] = wire_last_out;
+    wire_in[wire_head]  = wire_last_in;
+    wire_head = (wire_head + 1) % WIRE_MAX;
+}
+
+unsigned char UART_rxCount(void)
+{
+    return (rx_head - rx_tail) & UART_RxMask;
+}
+
+unsigned char UART_rxGet(void)
+{
+    unsigned char b = rx_buf[rx_tail];
+
+    rx_tail = (rx_tail + 1) & UART_RxMask;
+    return b;
+}
+
+static void pump(void)
+{
+    long long     t = now_us();
+    unsigned char b;
+
+    while (wire_tail != wire_head && wire_in[wire_tail] <= t) {
+        b = wire_b[wire_tail];
+        wire_tail = (wire_tail + 1) % WIRE_MAX;
+        if (loss && rand() % 1000 < loss) {
+            continue;
+        }
+        if (write(sock, &b, 1) < 0 && errno != EAGAIN) {
+            perror("write");
+            exit(1);
+        }
+    }
+    while (read(sock, &b, 1) == 1) {
+        // RX interrupt: lost when the ring is full
+        if (((rx_head + 1) & UART_RxMask) != rx_tail) {
+            rx_buf[rx_head] = b;
+            rx_head = (rx_head + 1) & UART_RxMask;
+        }
+    }
+}
+
+/* One board */
+
+static void board(int id, int secs, int desync)
+{
+    long long     t0, t, next, last;
+    unsigned long state = 0;
+    unsigned      session = 0, ms, frame_ms;
+    unsigned long lat_sum = 0, lat_n = 0, steps = 0;
+    unsigned      lat_max = 0;
+    unsigned      log_n = 0;
+    static unsigned      log_session[LOG_MAX];
+    static unsigned      log_step[LOG_MAX];
+    static unsigned long log_state[LOG_MAX];
+    int           acc = 0;
+    unsigned char angle = 64, in;
+    unsigned      i;
+    FILE          *out;
+    char          name[32];
+
+    srand(id * 7919 + (unsigned) getpid());
+    LINK_Config = (id == 1 && other_config) ? 0x5EED : 0xC0DE;
+    LINK_init((word) rand());
+
+    t0 = last = next = now_us();
+    while ((t = now_us()) < t0 + secs * 1000000LL) {
+        pump();
+        if (t < next) {
+            struct timespec ts = { 0, 200000 };
+            nanosleep(&ts, NULL);
+            continue;
+        }
+        // A frame takes 12 to 20 ms to draw
+        frame_ms = 12 + rand() % 9;
+        next = t + frame_ms * 1000;
+        ms = (unsigned) ((t - last) / 1000);
+        last += ms * 1000LL;
+        if (ms > 255) {
+            ms = 255;
+        }
+
+        if (LINK_poll((byte) ms) == LINK_Start) {
+            session++;
+            state = LINK_Seed;
+            acc = 0;
+        }
+        acc += ms;
+        if (acc > 80) {
+            acc = 80;
+        }
+        while (acc >= 20 && LINK_ready()) {
+            acc -= 20;
+            // Player: knob wanders, button now and then
+            angle = (angle + rand() % 5 - 2) & LINK_Angle;
+            in = angle | (rand() % 16 == 0 ? LINK_Btn : 0);
+            LINK_begin(in);
+            if (LINK_Frame >= LINK_Delay) {
+                lat_sum += LINK_LatLast;
+                lat_n++;
+                if (LINK_LatLast > lat_max) {
+                    lat_max = LINK_LatLast;
+                }
+            }
+
+            state = state * 1103515245UL + 12345 + LINK_In[0] * 31UL + LINK_In[1];
+            state &= 0xffffffffUL;
+            if (id == 0 && session == 1 && LINK_Frame == (word) desync) {
+                state ^= 1;
+            }
+            if (LINK_Frame % LOG_EVERY == 0 && log_n < LOG_MAX) {
+                log_session[log_n] = session;
+                log_step[log_n]    = LINK_Frame;
+                log_state[log_n]   = state;
+                log_n++;
+            }
+            steps++;
+            LINK_end((byte) (state ^ state >> 8 ^ state >> 16 ^ state >> 24));
+        }
+    }
+
+    printf("board %d: side %s  steps %lu  sessions %u  latency avg %.1f max %u ms"
+           "  rtt %u ms  resends %u  bad packets %u  desyncs %u  refused %u\n",
+           id, LINK_Side ? "R" : "L", steps, session,
+           lat_n ? (double) lat_sum / lat_n : 0.0, lat_max,
+           LINK_Rtt, LINK_Resends, LINK_BadPackets, LINK_Desyncs, LINK_Refused);
+
+    snprintf(name, sizeof name, "/tmp/linksim.%d.%d", (int) getppid(), id);
+    out = fopen(name, "w");
+    if (!out) {
+        perror(name);
+        exit(1);
+    }
+    for (i = 0; i < log_n; i++) {
+        fprintf(out, "%u %u %lu\n", log_session[i], log_step[i], log_state[i]);
+    }
+    fclose(out);
+    exit(0);
+}
+
+/* Both logs: same session and step must have the same hash */
+static void compare(void)
+{
+    FILE          *f[2];
+    char          name[32];
+    unsigned      s[2], n[2];
+    unsigned long h[2];
+    unsigned      same = 0, diff = 0;
+    int           i, ok[2];
+
+    for (i = 0; i < 2; i++) {
+        snprintf(name, sizeof name, "/tmp/linksim.%d.%d", (int) getpid(), i);
+        f[i] = fopen(name, "r");
+        if (!f[i]) {
+            perror(name);
+            exit(1);
+        }
+    }
+    ok[0] = fscanf(f[0], "%u %u %lu", &s[0], &n[0], &h[0]) == 3;
+    ok[1] = fscanf(f[1], "%u %u %lu", &s[1], &n[1], &h[1]) == 3;
+    while (ok[0] && ok[1]) {
+        if (s[0] == s[1] && n[0] == n[1]) {
+            if (h[0] == h[1]) {
+                same++;
+            }
+            else {
+                diff++;
+            }
+            ok[0] = fscanf(f[0], "%u %u %lu", &s[0], &n[0], &h[0]) == 3;
+            ok[1] = fscanf(f[1], "%u %u %lu", &s[1], &n[1], &h[1]) == 3;
+        }
+        else if (s[0] < s[1] || (s[0] == s[1] && n[0] < n[1])) {
+            ok[0] = fscanf(f[0], "%u %u %lu", &s[0], &n[0], &h[0]) == 3;
+        }
+        else {
+            ok[1] = fscanf(f[1], "%u %u %lu", &s[1], &n[1], &h[1]) == 3;
+        }
+    }
+    for (i = 0; i < 2; i++) {
+        fclose(f[i]);
+        snprintf(name, sizeof name, "/tmp/linksim.%d.%d", (int) getpid(), i);
+        remove(name);
+    }
+    printf("game hashes: %u match, %u differ\n", same, diff);
+}
+
+int main(int argc, char **argv)
+{
+    int   sv[2];
+    int   opt, i, status, fail = 0;
+    int   secs = 10, desync = -1;
+    pid_t pid[2];
+
+    lat_us = 5000;
+    while ((opt = getopt(argc, argv, "t:l:j:p:d:c")) != -1) {
+        switch (opt) {
+        case 't': secs      = atoi(optarg); break;
+        case 'l': lat_us    = atoi(optarg) * 1000; break;
+        case 'j': jitter_us = atoi(optarg) * 1000; break;
+        case 'p': loss      = atoi(optarg); break;
+        case 'd': desync    = atoi(optarg); break;
+        case 'c': other_config = 1; break;
+        default:
+            fprintf(stderr, "usage: %s [-t s] [-l ms] [-j ms] [-p loss] [-d step] [-c]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+        perror("socketpair");
+        return 1;
+    }
+    fflush(stdout);
+    for (i = 0; i < 2; i++) {
+        pid[i] = fork();
+        if (pid[i] < 0) {
+            perror("fork");
+            return 1;
+        }
+        if (pid[i] == 0) {
+            sock = sv[i];
+            close(sv[i ^ 1]);
+            fcntl(sock, F_SETFL, O_NONBLOCK);
+            board(i, secs, desync);
+        }
+    }
+    close(sv[0]);
+    close(sv[1]);
+    for (i = 0; i < 2; i++) {
+        waitpid(pid[i], &status, 0);
+        fail |= !WIFEXITED(status) || WEXITSTATUS(status);
+    }
+    if (fail) {
+        return 1;
+    }
+    compare();
+    return 0;
+}
@@ -0,0 +1,317 @@
+/*
+ * PIC Tennis attract rally generator
+ *
+ * Plays the display mode (mode 0) of firmware/src/main.c on Linux, cuts it
+ * into rallies (serve to next serve), keeps the ones with the most net
+ * crossings that fit the ROM budget and writes them as
+ * firmware/src/rally.c, which RALLY builds play back in mode 0. See rally.h
+ * for the format.
+ *
+ *   cc -O2 -Wno-unknown-pragmas -Ihost -I../firmware/src -o rallygen rallygen.c -lm
+ *   ./rallygen [-b bytes] [-n steps] [-s seed] [-c crossings] [-t steps]
+ *              [-e eeprom.bin] [-o rally.c]
+ *
+ *   -b  ROM budget for RALLY_Data (4096). With 0 the table is empty and
+ *       RALLY builds play the live game, for when the program memory is
+ *       short
+ *   -n  game steps to pick the rallies from (500000)
+ *   -s  seed, as gamesim's (1)
+ *   -c  fewest net crossings worth showing (6)
+ *   -t  steps kept after the last crossing (150), the ball dribbling out
+ *       until the next serve is dull
+ *   -e  court to record on, data EEPROM image as for gamesim. The firmware
+ *       only plays the rallies back on the same court (the view may differ)
+ *   -o  output file (stdout)
+ *
+ * The recording runs the float physics of the host, the board's own float
+ * library may round a little differently: a rally on the board is one the
+ * board could almost have played, which is all attract mode needs.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(RALLY)
+#error "rallygen records the live game, build it without RALLY"
+#endif
+
+#include "board.c"
+
+#define STEP_Max   (1L << 16)  // Longest rally kept, steps
+
+typedef struct
+{
+    float         x, y;        // Game units, after the step
+    float         vx, vy;      // Velocity for the next one
+    unsigned char wait;        // Waiting to be served
+} STEP;
+
+typedef struct
+{
+    long          first;       // Step the serve happened at
+    long          steps;
+    long          bytes;       // Encoded
+    int           crossings;
+    int           keep;
+    unsigned char *code;
+} RALLY_REC;
+
+static RALLY_REC *rally;
+static int        rally_n, rally_max;
+
+void HOST_sleep(void)
+{
+}
+
+static unsigned char unit(float v)
+{
+    v = floor(v);
+    return (unsigned char) (v < 0 ? 0 : v > 255 ? 255 : v);
+}
+
+// 8.8 of a game unit value, its integer part is the game unit
+static unsigned int fix8(float v)
+{
+    v = floor(v * 256);
+    return (unsigned int) (v < 0 ? 0 : v > 65535 ? 65535 : v);
+}
+
+static int off(unsigned int a, unsigned char b)
+{
+    return abs((int) (a >> 8) - (int) b) > RALLY_Error;
+}
+
+static long put16(unsigned char *code, long len, unsigned int v)
+{
+    code[len++] = (unsigned char) (v >> 8);
+    code[len++] = (unsigned char) v;
+    return len;
+}
+
+/*
+ * Encodes s[0..n-1] as RALLY_step() plays it back: a flight segment goes on
+ * while the integer model stays within RALLY_Error of every recorded step.
+ * NULL if a velocity doesn't fit 8.8
+ */
+static unsigned char *rally_encode(const STEP *s, long n, long *bytes)
+{
+    unsigned char *code = malloc(3 + n * 10);
+    long           i, len = 0, run;
+    unsigned int   x, y;
+    int            vx, vy;
+
+    code[len++] = RALLY_Serve;
+    code[len++] = unit(s[0].x);
+    code[len++] = unit(s[0].y);
+    for (i = 0; i < n; i += run) {
+        if (s[i].wait) {
+            for (run = 1; i + run < n && s[i + run].wait && run < 255; run++) {
+            }
+            code[len++] = RALLY_Wait;
+            code[len++] = (unsigned char) run;
+            continue;
+        }
+        if (fabs(s[i].vx) >= 127 || fabs(s[i].vy) >= 127) {
+            free(code);
+            return NULL;
+        }
+        x  = fix8(s[i].x);
+        y  = fix8(s[i].y);
+        vx = (int) floor(s[i].vx * 256 + 0.5);
+        vy = (int) floor(s[i].vy * 256 + 0.5);
+        code[len++] = RALLY_Fly;
+        code[len++] = 0;
+        len = put16(code, len, x);
+        len = put16(code, len, y);
+        len = put16(code, len, (unsigned int) vx);
+        len = put16(code, len, (unsigned int) vy);
+        for (run = 1; i + run < n && !s[i + run].wait && run < 255; run++) {
+            x  = (unsigned short) (x + vx);
+            y  = (unsigned short) (y + vy);
+            vy = vy - RALLY_Gravity;
+            if (off(x, unit(s[i + run].x)) || off(y, unit(s[i + run].y))) {
+                break;
+            }
+        }
+        code[len - 9] = (unsigned char) run;
+    }
+    *bytes = len;
+    return code;
+}
+
+static void rally_close(const STEP *s, long n, long first, long last_cross, int crossings,
+                        int min_cross, long max_tail)
+{
+    RALLY_REC r;
+
+    if (crossings < min_cross) {
+        return;
+    }
+    if (n > last_cross + max_tail) {
+        n = last_cross + max_tail;
+    }
+    r.code = rally_encode(s, n, &r.bytes);
+    if (!r.code) {
+        return;
+    }
+    r.first     = first;
+    r.steps     = n;
+    r.crossings = crossings;
+    r.keep      = 0;
+    if (rally_n == rally_max) {
+        rally_max = rally_max ? rally_max * 2 : 64;
+        rally     = realloc(rally, rally_max * sizeof *rally);
+    }
+    rally[rally_n++] = r;
+}
+
+// Most crossings per ROM byte first
+static int rally_cmp(const void *a, const void *b)
+{
+    const RALLY_REC *ra = *(const RALLY_REC * const *) a;
+    const RALLY_REC *rb = *(const RALLY_REC * const *) b;
+    double           da = (double) ra->crossings / ra->bytes;
+    double           db = (double) rb->crossings / rb->bytes;
+
+    return (da < db) - (da > db);
+}
+
+int main(int argc, char **argv)
+{
+    int            opt, i, side, crossings = 0, min_cross = 6, kept = 0;
+    long           budget = 4096, total = 0, n = 0, first = 0, last_cross = 0;
+    long           max_tail = 150, step, kept_steps = 0;
+    unsigned long  seed = 1, target = 500000;
+    const char    *out = NULL;
+    unsigned char  nCount;
+    unsigned int   iDelay;
+    STEP          *s = malloc(STEP_Max * sizeof *s);
+    RALLY_REC    **order;
+    FILE          *f;
+
+    memset(eeprom, 0xff, sizeof eeprom);
+    while ((opt = getopt(argc, argv, "b:n:s:c:t:e:o:")) != -1) {
+        switch (opt) {
+        case 'b': budget    = strtol(optarg, NULL, 0); break;
+        case 'n': target    = strtoul(optarg, NULL, 0); break;
+        case 's': seed      = strtoul(optarg, NULL, 0); break;
+        case 'c': min_cross = atoi(optarg); break;
+        case 't': max_tail  = strtol(optarg, NULL, 0); break;
+        case 'o': out       = optarg; break;
+        case 'e':
+            f = fopen(optarg, "rb");
+            if (!f || fread(eeprom, 1, sizeof eeprom, f) != sizeof eeprom) {
+                fprintf(stderr, "%s: can't read 256 bytes\n", optarg);
+                return 1;
+            }
+            fclose(f);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-b bytes] [-n steps] [-s seed] [-c crossings] [-t steps]\n"
+                            "       [-e eeprom.bin] [-o rally.c]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    // Display mode, nobody at the buttons
+    GAME_init((word) seed);
+    MODE_enter(MODE_Auto);
+    PORTAbits.RA2 = 1;
+    PORTAbits.RA4 = 1;
+
+    side = -1;
+    for (step = 0; step < (long) target; step++) {
+        nCount = nBallCount;
+        iDelay = iDelayNewBall;
+        GAME_step();
+        if (nBallCount != nCount) {
+            // Served: the rally before it is over (not the one power on cut)
+            if (side >= 0) {
+                rally_close(s, n, first, last_cross, crossings, min_cross, max_tail);
+            }
+            n          = 0;
+            first      = step;
+            crossings  = 0;
+            last_cross = 0;
+            side       = xNew >= Court.NetX;
+        }
+        if (side < 0) {
+            continue;
+        }
+        if (n == STEP_Max) {
+            // Endless, drop it
+            side = -1;
+            continue;
+        }
+        s[n].x    = xNew;
+        s[n].y    = yNew;
+        s[n].vx   = VxNew;
+        s[n].vy   = VyNew;
+        s[n].wait = iDelay > 0 || nBallCount != nCount;
+        if ((xNew >= Court.NetX) != side) {
+            side       = !side;
+            crossings++;
+            last_cross = n;
+        }
+        n++;
+    }
+
+    // Best ones that fit, played back in the order they were recorded
+    order = malloc((rally_n ? rally_n : 1) * sizeof *order);
+    for (i = 0; i < rally_n; i++) {
+        order[i] = &rally[i];
+    }
+    qsort(order, rally_n, sizeof *order, rally_cmp);
+    for (i = 0; i < rally_n; i++) {
+        if (total + order[i]->bytes + 1 <= budget) {
+            order[i]->keep = 1;
+            total += order[i]->bytes;
+            kept_steps += order[i]->steps;
+            kept++;
+        }
+    }
+
+    f = out ? fopen(out, "w") : stdout;
+    if (!f) {
+        perror(out);
+        return 1;
+    }
+    fprintf(f, "/*\n"
+               " * Attract mode rallies, see rally.h\n"
+               " * Generated by tools/rallygen.c, do not edit:\n"
+               " *   rallygen -b %ld -n %lu -s %lu -c %d -t %ld%s\n"
+               " * %d rallies of %d recorded, %ld steps (%ld s), %ld bytes\n"
+               " */\n\n",
+            budget, target, seed, min_cross, max_tail, eeprom[0] == 0xff ? "" : " -e <court>",
+            kept, rally_n, kept_steps, kept_steps * PHYS_Period / 1000, total + 1);
+    fprintf(f, "#include \"rally.h\"\n\n#if defined(RALLY)\n\n");
+    fprintf(f, "rom unsigned char RALLY_Court[RALLY_CourtSize] = {\n   ");
+    for (i = 0; i < RALLY_CourtSize; i++) {
+        fprintf(f, " %d,", ((unsigned char *) &Court)[i]);
+    }
+    fprintf(f, "\n};\n\nrom unsigned char RALLY_Data[] = {\n");
+    for (i = 0; i < rally_n; i++) {
+        long b;
+
+        if (!rally[i].keep) {
+            continue;
+        }
+        fprintf(f, "    // Step %ld: %d crossings, %ld steps\n",
+                rally[i].first, rally[i].crossings, rally[i].steps);
+        for (b = 0; b < rally[i].bytes; b++) {
+            fprintf(f, "%s0x%02x,%s", b % 12 ? " " : "    ", rally[i].code[b],
+                    b % 12 == 11 || b == rally[i].bytes - 1 ? "\n" : "");
+        }
+    }
+    fprintf(f, "    0x%02x\n};\n\n#endif\n", RALLY_Wrap);
+    if (out) {
+        fclose(f);
+    }
+    fprintf(stderr, "%d rallies of %d, %ld steps, %ld bytes\n", kept, rally_n, kept_steps, total + 1);
+    return 0;
+}
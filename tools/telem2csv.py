@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+PIC Tennis telemetry decoder
+
+Turns the binary records sent by TELEMETRY builds (see firmware/src/telem.h)
+into CSV. Reads a capture file or stdin, for instance:
+
+    stty -F /dev/ttyUSB0 19200 raw && cat /dev/ttyUSB0 | telem2csv.py > log.csv
+
+Records are found by their sync byte and checksum, so it picks up in the
+middle of a stream and skips garbage.
+
+One record covers the frames of at least 20 ms (the frames column says how
+many, frame_ms is their total) so at most 50 arrive a second; 19200 baud
+carries 80 at most. Dropped records are counted by the firmware in a byte
+that wraps, the dropped column is the running total.
+
+With --latency it prints the input to photon latency of PROFILE builds
+instead: p50, p99 and max (ms) per mode, without and with the debug overlay.
+A record carries the last probe of the frames it covers, so this is a sample
+of the probes the board's own histograms count.
+"""
+
+import struct
+import sys
+
+SYNC = 0xA5
+RECORD = struct.Struct("<BHBBbbBBBBB8sBBBB")
+STAGES = ("mode", "adc", "phys", "hit", "trail", "ball", "ground", "debug")
+
+COLUMNS = (
+    ["frame", "x", "y", "vx", "vy", "l_angle", "r_angle",
+     "l_btn", "r_btn", "side", "dead_ball", "debug", "mode",
+     "hits", "frame_ms"]
+    + ["tick_" + s for s in STAGES]
+    + ["dropped", "frames", "lat_ms"]
+)
+
+LAT_NONE = 255
+
+
+def records(stream):
+    buf = b""
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            return
+        buf += chunk
+        while len(buf) >= RECORD.size:
+            if buf[0] != SYNC or sum(buf[:RECORD.size]) & 0xFF:
+                buf = buf[1:]
+                continue
+            yield RECORD.unpack_from(buf)
+            buf = buf[RECORD.size:]
+
+
+def row(rec, dropped):
+    (_, frame, x, y, vx, vy, l_angle, r_angle, flags, hits, frame_ms,
+     stages, _, frames, lat_ms, _) = rec
+    out = [frame, x, y, vx / 16.0, vy / 16.0, l_angle, r_angle,
+           flags & 1, (flags >> 1) & 1, (flags >> 2) & 1, (flags >> 3) & 1,
+           (flags >> 4) & 1, (flags >> 5) & 3, hits, frame_ms]
+    out += [c * 64 for c in stages]
+    out += [dropped, frames]
+    out.append("" if lat_ms == LAT_NONE else lat_ms)
+    return out
+
+
+def percentile(values, pct):
+    values = sorted(values)
+    return values[max(0, -(-len(values) * pct // 100) - 1)]
+
+
+def latency(stream):
+    sets = {}
+    for rec in records(stream):
+        flags, lat_ms = rec[8], rec[14]
+        if lat_ms != LAT_NONE:
+            key = ((flags >> 5) & 3, (flags >> 4) & 1)
+            sets.setdefault(key, []).append(lat_ms)
+    print("mode,debug,probes,p50_ms,p99_ms,max_ms")
+    for (mode, debug), values in sorted(sets.items()):
+        print("%d,%d,%d,%d,%d,%d" % (mode, debug, len(values), percentile(values, 50),
+                                     percentile(values, 99), max(values)))
+
+
+def main(argv):
+    args = [a for a in argv[1:] if a != "--latency"]
+    stream = open(args[0], "rb") if args else sys.stdin.buffer
+    if "--latency" in argv:
+        latency(stream)
+        return
+    print(",".join(COLUMNS))
+    dropped = last = None
+    for rec in records(stream):
+        if last is None:
+            dropped = rec[12]
+        else:
+            dropped += (rec[12] - last) & 0xFF
+        last = rec[12]
+        print(",".join(str(v) for v in row(rec, dropped)))
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main(sys.argv)
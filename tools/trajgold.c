@@ -0,0 +1,285 @@
+/*
+ * PIC Tennis golden trajectories
+ *
+ * Records the ball flights of the float physics of firmware/src/main.c
+ * over a grid of launches, and checks another physics build (PHYS_SEGMENT,
+ * or the float code after a change) against them: per step position and
+ * velocity error, the step where the flight diverges and the rule outcomes
+ * that differ (side changes, nDeadBall, nBallHits).
+ *
+ *   cc -O2 -Wno-unknown-pragmas -Ihost -I../firmware/src -o trajgold trajgold.c -lm
+ *   ./trajgold -o golden.txt [-a step] [-s seeds] [-n steps]
+ *   ./trajgold -c golden.txt [-p tol] [-v tol] [-F] [-t case]
+ *
+ *   -o  record the grid to this file
+ *   -a  launch angle step (16): angles step/2, step/2 + step, ... up to 127,
+ *       through getCustomSin/Cos as PHYS_launch() takes them
+ *   -s  autoplayer seeds, comma separated (1,2)
+ *   -n  game steps recorded per launch (600)
+ *   -c  run the grid of this golden file and compare
+ *   -p  position tolerance, game units (0.5)
+ *   -v  velocity tolerance, game units per step (0.05)
+ *   -F  rule outcome mismatches are reported but don't fail
+ *   -t  print every step of this case (its number in the report)
+ *
+ * A case is a launch from the serve point of one side at one angle, then
+ * the autoplayers of mode 0 carry on the rally with GAME_rand() seeded as
+ * given, serves included. Once a flight diverges the autoplayers decide on
+ * different positions and the rest of the case has little to say: the
+ * report gives the first step over the tolerance and the first rule
+ * mismatch, the exit status is 1 if any case fails.
+ *
+ * tools/golden/traj.txt is the set the float physics recorded with the
+ * defaults. Record it again only when the float game is meant to change.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "board.c"
+
+#define SEED_Max   16
+
+typedef struct
+{
+    float         x, y, vx, vy;
+    unsigned char side, dead, hits;
+} TSTEP;
+
+void HOST_sleep(void)
+{
+}
+
+/*
+ * One case into t[0..n-1]: mode 0 on the default court, the ball launched
+ * from the serve point of side at angle, as a hit of that side's player
+ */
+static void traj_run(unsigned seed, unsigned side, unsigned angle, long n, TSTEP *t)
+{
+    long i;
+
+    GAME_init((word) seed);
+    MODE_enter(MODE_Auto);
+    PORTAbits.RA2   = 1;
+    PORTAbits.RA4   = 1;
+
+    nSide         = side;
+    nBallHits     = 0;
+    nDeadBall     = 0;
+    L_used        = 0;
+    R_used        = 0;
+    iDelayNewBall = 0;
+    xOld          = side ? Ball_R : Ball_L;
+    yOld          = Ball_H;
+    PHYS_launch((unsigned char) side, (unsigned char) angle);
+    VxOld = VxNew;
+    VyOld = VyNew;
+    TRAIL_fill(0, (unsigned char) xOld, (unsigned char) yOld);
+    BALL_store(0);
+
+    for (i = 0; i < n; i++) {
+        GAME_step();
+        t[i].x    = xOld;
+        t[i].y    = yOld;
+        t[i].vx   = VxOld;
+        t[i].vy   = VyOld;
+        t[i].side = nSide;
+        t[i].dead = nDeadBall;
+        t[i].hits = nBallHits;
+    }
+}
+
+static int seeds_parse(const char *s, unsigned *seed)
+{
+    int   n = 0;
+    char *end;
+
+    while (*s && n < SEED_Max) {
+        seed[n++] = (unsigned) strtoul(s, &end, 0);
+        if (end == s) {
+            return 0;
+        }
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return n;
+}
+
+static float fdiff(float a, float b)
+{
+    return a > b ? a - b : b - a;
+}
+
+static int record(const char *out, int step, const unsigned *seed, int seeds, long n)
+{
+    FILE    *f = fopen(out, "w");
+    TSTEP   *t = malloc(n * sizeof *t);
+    int      s, side, angle;
+    long     i;
+
+    if (!f) {
+        perror(out);
+        return 1;
+    }
+    fprintf(f, "# Golden trajectories, written by tools/trajgold.c, do not edit\n");
+    fprintf(f, "# case: seed side angle, then x y vx vy side dead hits per step\n");
+    fprintf(f, "grid %d %ld\n", step, n);
+    for (s = 0; s < seeds; s++) {
+        for (side = 0; side < 2; side++) {
+            for (angle = step / 2; angle < 128; angle += step) {
+                traj_run(seed[s], side, angle, n, t);
+                fprintf(f, "case %u %d %d\n", seed[s], side, angle);
+                for (i = 0; i < n; i++) {
+                    fprintf(f, "%.3f %.3f %.3f %.3f %u %u %u\n", t[i].x, t[i].y, t[i].vx,
+                            t[i].vy, t[i].side, t[i].dead, t[i].hits);
+                }
+            }
+        }
+    }
+    fclose(f);
+    free(t);
+    return 0;
+}
+
+static int compare(const char *in, float ptol, float vtol, int flags_fail, int trace)
+{
+    FILE     *f = fopen(in, "r");
+    char      line[256];
+    TSTEP    *gold = NULL, *t = NULL;
+    unsigned  seed, side, angle, u[3];
+    int       step, cases = 0, failed = 0, bad;
+    long      n = 0, i, diverge, rule;
+    float     pmax, vmax, d;
+    const char *what;
+
+    if (!f) {
+        perror(in);
+        return 2;
+    }
+    while (fgets(line, sizeof line, f)) {
+        if (line[0] == '#') {
+            continue;
+        }
+        if (sscanf(line, "grid %d %ld", &step, &n) == 2) {
+            gold = malloc(n * sizeof *gold);
+            t = malloc(n * sizeof *t);
+            continue;
+        }
+        if (!gold || sscanf(line, "case %u %u %u", &seed, &side, &angle) != 3) {
+            fprintf(stderr, "%s: not a golden file\n", in);
+            return 2;
+        }
+        for (i = 0; i < n; i++) {
+            if (!fgets(line, sizeof line, f)
+                || sscanf(line, "%f %f %f %f %u %u %u", &gold[i].x, &gold[i].y,
+                          &gold[i].vx, &gold[i].vy, &u[0], &u[1], &u[2]) != 7) {
+                fprintf(stderr, "%s: case %d truncated\n", in, cases);
+                return 2;
+            }
+            gold[i].side = u[0];
+            gold[i].dead = u[1];
+            gold[i].hits = u[2];
+        }
+
+        traj_run(seed, side, angle, n, t);
+        pmax    = 0;
+        vmax    = 0;
+        diverge = -1;
+        rule    = -1;
+        what    = "";
+        for (i = 0; i < n; i++) {
+            d = fdiff(gold[i].x, t[i].x) > fdiff(gold[i].y, t[i].y)
+              ? fdiff(gold[i].x, t[i].x) : fdiff(gold[i].y, t[i].y);
+            if (diverge < 0) {
+                pmax = d > pmax ? d : pmax;
+                d    = fdiff(gold[i].vx, t[i].vx) > fdiff(gold[i].vy, t[i].vy)
+                     ? fdiff(gold[i].vx, t[i].vx) : fdiff(gold[i].vy, t[i].vy);
+                vmax = d > vmax ? d : vmax;
+                if (pmax > ptol || vmax > vtol) {
+                    diverge = i;
+                }
+            }
+            if (rule < 0) {
+                what = gold[i].side != t[i].side ? "side"
+                     : gold[i].dead != t[i].dead ? "dead ball"
+                     : gold[i].hits != t[i].hits ? "hits" : NULL;
+                if (what) {
+                    rule = i;
+                }
+                else {
+                    what = "";
+                }
+            }
+            if (trace == cases) {
+                printf("%4ld  x %8.3f %8.3f  y %8.3f %8.3f  vx %7.3f %7.3f  vy %7.3f %7.3f"
+                       "  side %u %u  dead %u %u  hits %2u %2u\n",
+                       i, gold[i].x, t[i].x, gold[i].y, t[i].y, gold[i].vx, t[i].vx,
+                       gold[i].vy, t[i].vy,
+                       gold[i].side, t[i].side, gold[i].dead, t[i].dead, gold[i].hits, t[i].hits);
+            }
+        }
+
+        bad = diverge >= 0 || (flags_fail && rule >= 0);
+        failed += bad;
+        printf("%3d seed %u side %u angle %3u: pos %.3f vel %.3f", cases, seed, side, angle,
+               pmax, vmax);
+        if (diverge >= 0) {
+            printf(", diverges at step %ld", diverge);
+        }
+        if (rule >= 0) {
+            printf(", %s differs at step %ld (%u/%u/%u, golden %u/%u/%u)", what, rule,
+                   t[rule].side, t[rule].dead, t[rule].hits,
+                   gold[rule].side, gold[rule].dead, gold[rule].hits);
+        }
+        printf("%s\n", bad ? "  FAIL" : "");
+        cases++;
+    }
+    fclose(f);
+    printf("%d of %d cases within pos %.3f vel %.3f%s\n", cases - failed, cases, ptol, vtol,
+           flags_fail ? " and the same rule outcomes" : "");
+    free(gold);
+    free(t);
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    int         opt, step = 16, seeds = 2, flags_fail = 1, trace = -1;
+    unsigned    seed[SEED_Max] = { 1, 2 };
+    long        n = 600;
+    float       ptol = 0.5, vtol = 0.05;
+    const char *out = NULL, *in = NULL;
+
+    memset(eeprom, 0xff, sizeof eeprom);
+    while ((opt = getopt(argc, argv, "o:a:s:n:c:p:v:Ft:")) != -1) {
+        switch (opt) {
+        case 'o': out  = optarg; break;
+        case 'a': step = atoi(optarg); break;
+        case 'n': n    = strtol(optarg, NULL, 0); break;
+        case 'c': in   = optarg; break;
+        case 'p': ptol = strtof(optarg, NULL); break;
+        case 'v': vtol = strtof(optarg, NULL); break;
+        case 'F': flags_fail = 0; break;
+        case 't': trace = atoi(optarg); break;
+        case 's':
+            seeds = seeds_parse(optarg, seed);
+            if (seeds) {
+                break;
+            }
+            /* fall through */
+        default:
+            fprintf(stderr, "usage: %s -o golden.txt [-a step] [-s seeds] [-n steps]\n"
+                            "       %s -c golden.txt [-p tol] [-v tol] [-F] [-t case]\n",
+                    argv[0], argv[0]);
+            return 2;
+        }
+    }
+    if (step < 1 || n < 1 || (!out == !in)) {
+        fprintf(stderr, "%s: one of -o or -c\n", argv[0]);
+        return 2;
+    }
+    return out ? record(out, step, seed, seeds, n) : compare(in, ptol, vtol, flags_fail, trace);
+}
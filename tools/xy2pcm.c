@@ -0,0 +1,174 @@
+/*
+ * PIC Tennis XY trace to sound card
+ *
+ * Plays a DAC trace (see xytrace.h) on a stereo sound card wired to an XY
+ * scope, or writes it to a WAV file. X is the left channel, Y the right.
+ *
+ *   cc -O2 -o xy2pcm xy2pcm.c xypcm.c
+ *   ./xy2pcm [-r rate] [-f fcy] [-w | -s] [-o out] [trace]
+ *   ./xy2pcm -w -o court.wav -p 5
+ *   ./xy2pcm -p 60 | aplay -f S16_LE -c 2 -r 192000
+ *
+ *   -r  output sample rate, Hz (192000)
+ *   -f  trace ticks per second, the PIC instruction clock (1000000 at 4 MHz)
+ *   -w  WAV, the default when -o names a file
+ *   -s  raw S16_LE, the default on stdout
+ *   -o  output file (stdout)
+ *   -p  no trace, draw the court and a bouncing ball for this many seconds
+ *       with the firmware sample timings, to check the scope and the card
+ *
+ * Reads the trace from the file or stdin in fixed blocks and writes in
+ * fixed blocks, so it keeps up with a pipe from a live capture.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "xytrace.h"
+#include "xypcm.h"
+
+#define READ_BLOCK  4096            // Records per fread
+
+/* Sample timings of firmware/src/dac.c, cycles */
+#define CY_RUN      5
+#define CY_DWELL    6
+#define CY_WRITE    4               // Setting a point from C
+
+static xypcm pcm;
+
+/* Test pattern */
+
+static uint32_t pat_tick;
+
+static void pat_put(uint8_t x, uint8_t y, uint32_t cycles)
+{
+    xypcm_put(&pcm, pat_tick, x, y);
+    pat_tick += cycles;
+}
+
+static uint8_t pat_runx(uint8_t x, uint8_t y, int n, int step)
+{
+    for (; n > 0; n--) {
+        pat_put(x, y, CY_RUN);
+        x += step;
+    }
+    return x;
+}
+
+static uint8_t pat_runy(uint8_t x, uint8_t y, int n, int step)
+{
+    for (; n > 0; n--) {
+        pat_put(x, y, CY_RUN);
+        y += step;
+    }
+    return y;
+}
+
+/* XY_drawGround() twice, then the ball dwelling on a bouncing path */
+static void pattern(uint32_t secs, uint32_t fcy)
+{
+    uint32_t end = secs * fcy;
+    uint8_t  x, y;
+    int      k, bx = 20, vx = 2, by = 100, vy = 0;
+
+    while (pat_tick < end) {
+        for (k = 0; k < 2; k++) {
+            x = y = 0;
+            pat_put(x, y, CY_WRITE);
+            x = pat_runx(x, y, 127, 1);
+            y = pat_runy(x, y, 61, 1);
+            y = pat_runy(x, y, 60, -1);
+            pat_put(x, y, CY_WRITE);
+            x = pat_runx(x, y, 128, 1);
+        }
+        pat_put((uint8_t) bx, (uint8_t) by, CY_DWELL * 250);
+        bx += vx;
+        if (bx < 4 || bx > 250) {
+            vx = -vx;
+        }
+        vy -= 1;
+        by += vy / 2;
+        if (by <= 0) {
+            by = 0;
+            vy = 22;
+        }
+    }
+    xypcm_close(&pcm, pat_tick);
+}
+
+/* Trace file */
+
+static int convert(FILE *in)
+{
+    static unsigned char buf[READ_BLOCK * 8];
+    size_t   n, i;
+    unsigned char *r;
+    uint32_t tick = 0;
+
+    while ((n = fread(buf, 8, READ_BLOCK, in)) > 0) {
+        for (i = 0; i < n; i++) {
+            r = buf + i * 8;
+            tick = r[0] | r[1] << 8 | r[2] << 16 | (uint32_t) r[3] << 24;
+            xypcm_put(&pcm, tick, r[4], r[5]);
+        }
+    }
+    if (ferror(in)) {
+        perror("read");
+        return 1;
+    }
+    // The last point gets one run sample
+    return xypcm_close(&pcm, tick + CY_RUN) < 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rate = 192000, fcy = 1000000, secs = 0;
+    int      opt, wav = -1;
+    const char *name = NULL;
+    FILE     *in = stdin, *out = stdout;
+
+    while ((opt = getopt(argc, argv, "r:f:wso:p:")) != -1) {
+        switch (opt) {
+        case 'r': rate = (uint32_t) strtoul(optarg, NULL, 10); break;
+        case 'f': fcy  = (uint32_t) strtoul(optarg, NULL, 10); break;
+        case 'w': wav  = 1; break;
+        case 's': wav  = 0; break;
+        case 'o': name = optarg; break;
+        case 'p': secs = (uint32_t) strtoul(optarg, NULL, 10); break;
+        default:
+            fprintf(stderr, "usage: %s [-r rate] [-f fcy] [-w | -s] [-o out] [-p s | trace]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (optind < argc && !secs) {
+        in = fopen(argv[optind], "rb");
+        if (!in) {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+    if (name) {
+        out = fopen(name, "wb");
+        if (!out) {
+            perror(name);
+            return 1;
+        }
+    }
+    if (wav < 0) {
+        wav = name != NULL;
+    }
+    if (xypcm_open(&pcm, out, rate, fcy, wav) < 0) {
+        fprintf(stderr, "bad rate or clock\n");
+        return 2;
+    }
+
+    if (secs) {
+        pattern(secs, fcy);
+        return ferror(out) ? 1 : 0;
+    }
+    return convert(in);
+}
@@ -0,0 +1,147 @@
+/*
+ * PIC Tennis XY to PCM, see xypcm.h
+ *
+ * Time is kept in ticks * rate so both the DAC writes and the output sample
+ * edges (every fcy units) fall on integers: no drift and no floating point.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "xypcm.h"
+
+static void put16(unsigned char *p, uint32_t v)
+{
+    p[0] = (unsigned char) v;
+    p[1] = (unsigned char) (v >> 8);
+}
+
+static void put32(unsigned char *p, uint32_t v)
+{
+    put16(p, v & 0xffff);
+    put16(p + 2, v >> 16);
+}
+
+static int write_header(xypcm *p, uint32_t data)
+{
+    unsigned char h[44];
+
+    memcpy(h, "RIFF", 4);
+    put32(h + 4, data > 0xffffffffUL - 36 ? 0xffffffffUL : data + 36);
+    memcpy(h + 8, "WAVEfmt ", 8);
+    put32(h + 16, 16);
+    put16(h + 20, 1);               // PCM
+    put16(h + 22, 2);               // Left X, right Y
+    put32(h + 24, p->rate);
+    put32(h + 28, p->rate * 4);
+    put16(h + 32, 4);
+    put16(h + 34, 16);
+    memcpy(h + 36, "data", 4);
+    put32(h + 40, data);
+    return fwrite(h, sizeof h, 1, p->out) == 1 ? 0 : -1;
+}
+
+static void flush(xypcm *p)
+{
+    if (p->fill) {
+        fwrite(p->buf, 4, p->fill, p->out);
+        p->fill = 0;
+    }
+}
+
+/* DAC code 0-255 held for the whole sample is -32768 to 32512 */
+static int16_t level(uint64_t sum, uint32_t fcy)
+{
+    return (int16_t) ((int32_t) (sum * 256 / fcy) - 32768);
+}
+
+static void emit(xypcm *p)
+{
+    int16_t l = level(p->sum_x, p->fcy);
+    int16_t r = level(p->sum_y, p->fcy);
+    unsigned char *b = (unsigned char *) &p->buf[2 * p->fill];
+
+    // Little endian whatever the host is
+    put16(b, (uint16_t) l);
+    put16(b + 2, (uint16_t) r);
+    p->sum_x = p->sum_y = 0;
+    p->frames++;
+    if (++p->fill == XYPCM_BLOCK) {
+        flush(p);
+    }
+}
+
+/* Hold the current value for n ticks */
+static void hold(xypcm *p, uint32_t n)
+{
+    uint64_t t = (uint64_t) n * p->rate;
+    uint64_t left;
+
+    while (t) {
+        left = p->fcy - p->pos;
+        if (t < left) {
+            p->sum_x += p->x * t;
+            p->sum_y += p->y * t;
+            p->pos   += t;
+            return;
+        }
+        p->sum_x += p->x * left;
+        p->sum_y += p->y * left;
+        t -= left;
+        p->pos = 0;
+        emit(p);
+        // Whole samples at one value
+        while (t >= p->fcy) {
+            p->sum_x = (uint64_t) p->x * p->fcy;
+            p->sum_y = (uint64_t) p->y * p->fcy;
+            t -= p->fcy;
+            emit(p);
+        }
+    }
+}
+
+int xypcm_open(xypcm *p, FILE *out, uint32_t rate, uint32_t fcy, int wav)
+{
+    memset(p, 0, offsetof(xypcm, buf));
+    p->out  = out;
+    p->wav  = wav;
+    p->rate = rate;
+    p->fcy  = fcy;
+    p->x = p->y = 128;
+    if (!rate || !fcy) {
+        return -1;
+    }
+    // Unknown length: the streaming convention is the largest size
+    return wav ? write_header(p, 0xffffffffUL) : 0;
+}
+
+void xypcm_put(xypcm *p, uint32_t tick, uint8_t x, uint8_t y)
+{
+    if (p->started) {
+        // Wraps like the tick counter
+        hold(p, tick - p->tick);
+    }
+    p->started = 1;
+    p->tick = tick;
+    p->x = x;
+    p->y = y;
+}
+
+int xypcm_close(xypcm *p, uint32_t tick)
+{
+    uint64_t data;
+
+    if (p->started) {
+        hold(p, tick - p->tick);
+        p->tick = tick;
+    }
+    flush(p);
+    if (p->wav && fseek(p->out, 0, SEEK_SET) == 0) {
+        data = p->frames * 4;
+        if (write_header(p, data > 0xffffffffUL ? 0xffffffffUL : (uint32_t) data) < 0) {
+            return -1;
+        }
+        fseek(p->out, 0, SEEK_END);
+    }
+    return fflush(p->out) == 0 && !ferror(p->out) ? 0 : -1;
+}
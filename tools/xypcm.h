@@ -0,0 +1,55 @@
+/*
+ * PIC Tennis XY to PCM
+ *
+ * Turns the DAC write stream (see xytrace.h) into stereo 16 bit PCM for a
+ * sound card driving an XY scope: X on the left channel, Y on the right.
+ * Each output sample is the average of the DAC values over its period (a
+ * box filter), computed exactly in integers. Memory is fixed: one block of
+ * output frames inside the xypcm struct, nothing is allocated.
+ *
+ *   xypcm p;
+ *   xypcm_open(&p, stdout, 192000, 1000000, 1);
+ *   xypcm_put(&p, tick, x, y);     // for every DAC write
+ *   xypcm_close(&p);
+ */
+
+#ifndef XYPCM_H
+#define XYPCM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define XYPCM_BLOCK  4096           // Frames per fwrite
+
+typedef struct {
+    FILE     *out;
+    int      wav;                   // Write a WAV header
+    uint32_t rate;                  // Output samples per second
+    uint32_t fcy;                   // DAC ticks per second
+    int      started;
+    uint32_t tick;                  // Tick of the value being held
+    uint8_t  x, y;                  // Value being held
+    uint64_t pos;                   // Time in ticks * rate since the sample start
+    uint64_t sum_x, sum_y;          // Value * time so far in this sample
+    uint64_t frames;                // Frames written
+    unsigned fill;
+    int16_t  buf[2 * XYPCM_BLOCK];
+} xypcm;
+
+/**
+ * Start a stream. With wav set a header is written first, its sizes are
+ * fixed up by xypcm_close() when the file can seek (not on a pipe)
+ */
+int  xypcm_open(xypcm *p, FILE *out, uint32_t rate, uint32_t fcy, int wav);
+
+/**
+ * DAC write at tick: the previous value is held until then
+ */
+void xypcm_put(xypcm *p, uint32_t tick, uint8_t x, uint8_t y);
+
+/**
+ * Hold the last value until tick, then flush and fix the WAV header
+ */
+int  xypcm_close(xypcm *p, uint32_t tick);
+
+#endif
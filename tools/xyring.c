@@ -0,0 +1,201 @@
+/*
+ * PIC Tennis DAC trace ring tool
+ *
+ *   cc -O2 -o xyring xyring.c xytrace.c
+ *   ./xyring info ring
+ *   ./xyring cat [-f] ring > trace          flat trace, see xytrace.h
+ *   ./xyring bench [-n records] [-b bits] ring
+ *
+ *   cat    copies the records from the oldest intact one, -f keeps tailing
+ *          until the writer closes the ring. Overwritten records are
+ *          counted on stderr
+ *   bench  writes the court pattern (XY_drawGround() sample by sample) into
+ *          the ring and times it against the same loop without capture
+ *
+ * A live run plays while it is written:
+ *   ./xyring bench -n 2000000000 court.ring &
+ *   ./xyring cat -f court.ring | ./xy2pcm -s | aplay -f S16_LE -c 2 -r 192000
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "xytrace.h"
+
+#define CAT_BLOCK   4096
+#define CY_RUN      5               // dac.c run loop, cycles per sample
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int info(const char *path)
+{
+    xyt_ring r;
+    uint64_t head, tail;
+
+    if (xyt_open(&r, path) < 0) {
+        fprintf(stderr, "%s: not a trace ring\n", path);
+        return 1;
+    }
+    head = atomic_load(&r.hdr->head);
+    tail = atomic_load(&r.hdr->tail);
+    printf("version %u  capacity %u  fcy %u  head %llu  tail %llu  %s\n",
+           r.hdr->version, r.hdr->capacity, r.hdr->fcy,
+           (unsigned long long) head, (unsigned long long) tail,
+           (atomic_load(&r.hdr->flags) & XYT_CLOSED) ? "closed" : "open");
+    xyt_close(&r, 0);
+    return 0;
+}
+
+static int cat(const char *path, int follow)
+{
+    static xyt_rec buf[CAT_BLOCK];
+    xyt_ring r;
+    uint64_t lost, lost_all = 0, n_all = 0;
+    long     n;
+    struct timespec ts = { 0, 1000000 };
+
+    if (xyt_open(&r, path) < 0) {
+        fprintf(stderr, "%s: not a trace ring\n", path);
+        return 1;
+    }
+    for (;;) {
+        n = xyt_read(&r, buf, CAT_BLOCK, &lost);
+        lost_all += lost;
+        if (n > 0) {
+            if (fwrite(buf, sizeof *buf, (size_t) n, stdout) != (size_t) n) {
+                break;
+            }
+            n_all += (uint64_t) n;
+        }
+        else if (n < 0 || !follow) {
+            break;
+        }
+        else {
+            fflush(stdout);
+            nanosleep(&ts, NULL);
+        }
+    }
+    xyt_close(&r, 0);
+    fprintf(stderr, "%llu records, %llu overwritten before read\n",
+            (unsigned long long) n_all, (unsigned long long) lost_all);
+    return 0;
+}
+
+/* The ground twice per frame; capture NULL runs the same loop without it */
+static uint32_t sink;
+
+static void court(xyt_ring *capture, uint64_t n)
+{
+    uint32_t tick = 0;
+    uint8_t  x, y;
+    int      k, i;
+
+    while (n) {
+        x = y = 0;
+        for (k = 0; k < 4 && n; k++) {
+            // Along the ground, up and down the net, on to the right
+            int len  = k == 0 ? 127 : k == 1 ? 61 : k == 2 ? 60 : 128;
+            int dx   = k == 0 || k == 3;
+            int step = k == 2 ? -1 : 1;
+
+            for (i = 0; i < len && n; i++, n--) {
+                if (capture) {
+                    xyt_put(capture, tick, x, y, XYT_TAG_GROUND);
+                }
+                else {
+                    sink += x ^ y ^ tick;
+                }
+                tick += CY_RUN;
+                if (dx) {
+                    x += step;
+                }
+                else {
+                    y += step;
+                }
+            }
+        }
+    }
+}
+
+static int bench(const char *path, uint64_t n, unsigned bits)
+{
+    xyt_ring r;
+    double   t0, t_plain, t_ring;
+
+    if (xyt_create(&r, path, bits, 1000000) < 0) {
+        perror(path);
+        return 1;
+    }
+    // Fault the pages in first, a long run has them mapped after one lap
+    court(&r, (uint64_t) r.mask + 1);
+    xyt_close(&r, 1);
+    if (xyt_create(&r, path, bits, 1000000) < 0) {
+        perror(path);
+        return 1;
+    }
+
+    t0 = now_s();
+    court(NULL, n);
+    t_plain = now_s() - t0;
+
+    t0 = now_s();
+    court(&r, n);
+    t_ring = now_s() - t0;
+    xyt_close(&r, 1);
+
+    printf("%llu records: %.3f s without capture, %.3f s with, %.2f ns per record"
+           " (%.0f M records/s)\n",
+           (unsigned long long) n, t_plain, t_ring,
+           (t_ring - t_plain) * 1e9 / (double) n, n / t_ring * 1e-6);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int        opt, follow = 0;
+    unsigned   bits = 24;
+    uint64_t   n = 100000000;
+    const char *cmd;
+
+    if (argc < 2) {
+        goto usage;
+    }
+    cmd = argv[1];
+    optind = 2;
+    while ((opt = getopt(argc, argv, "fn:b:")) != -1) {
+        switch (opt) {
+        case 'f': follow = 1; break;
+        case 'n': n      = strtoull(optarg, NULL, 10); break;
+        case 'b': bits   = (unsigned) atoi(optarg); break;
+        default:  goto usage;
+        }
+    }
+    if (optind != argc - 1) {
+        goto usage;
+    }
+    if (strcmp(cmd, "info") == 0) {
+        return info(argv[optind]);
+    }
+    if (strcmp(cmd, "cat") == 0) {
+        return cat(argv[optind], follow);
+    }
+    if (strcmp(cmd, "bench") == 0) {
+        return bench(argv[optind], n, bits);
+    }
+
+usage:
+    fprintf(stderr, "usage: %s info ring | cat [-f] ring | bench [-n records] [-b bits] ring\n",
+            argv[0]);
+    return 2;
+}
@@ -0,0 +1,160 @@
+/*
+ * PIC Tennis DAC trace ring, see xytrace.h
+ *
+ * Records are stored in host order, the format says little endian so the
+ * ring is only shared between little endian hosts.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "xytrace.h"
+
+_Static_assert(sizeof(xyt_rec) == 8, "trace record is 8 bytes");
+_Static_assert(sizeof(xyt_header) == XYT_HEADER, "ring header is 128 bytes");
+_Static_assert(offsetof(xyt_header, head) == 64, "head at 64");
+_Static_assert(offsetof(xyt_header, tail) == 72, "tail at 72");
+
+static int map(xyt_ring *r, int fd, uint64_t size, int prot)
+{
+    void *p = mmap(NULL, size, prot, MAP_SHARED, fd, 0);
+
+    close(fd);
+    if (p == MAP_FAILED) {
+        return -1;
+    }
+    r->hdr  = p;
+    r->rec  = (xyt_rec *) ((char *) p + XYT_HEADER);
+    r->size = size;
+    return 0;
+}
+
+int xyt_create(xyt_ring *r, const char *path, unsigned bits, uint32_t fcy)
+{
+    uint64_t size;
+    int      fd;
+
+    if (bits < 10 || bits > 31) {
+        return -1;
+    }
+    size = XYT_HEADER + ((uint64_t) 8 << bits);
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return -1;
+    }
+    if (ftruncate(fd, (off_t) size) < 0 || map(r, fd, size, PROT_READ | PROT_WRITE) < 0) {
+        close(fd);
+        return -1;
+    }
+    // ftruncate gave zeros, head and tail are 0
+    memcpy(r->hdr->magic, XYT_MAGIC, 4);
+    r->hdr->version  = XYT_VERSION;
+    r->hdr->rec_size = sizeof(xyt_rec);
+    r->hdr->capacity = (uint32_t) 1 << bits;
+    r->hdr->fcy      = fcy;
+    r->mask = r->hdr->capacity - 1;
+    r->pos  = 0;
+    r->end  = 0;
+    xyt_commit(r);
+    return 0;
+}
+
+int xyt_open(xyt_ring *r, const char *path)
+{
+    struct stat st;
+    xyt_header  h;
+    int         fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    if (fstat(fd, &st) < 0 || (uint64_t) st.st_size < XYT_HEADER
+        || pread(fd, &h, sizeof h, 0) != sizeof h
+        || memcmp(h.magic, XYT_MAGIC, 4) != 0 || h.version != XYT_VERSION
+        || h.rec_size != sizeof(xyt_rec) || h.capacity == 0
+        || (h.capacity & (h.capacity - 1)) != 0
+        || (uint64_t) st.st_size < XYT_HEADER + (uint64_t) h.capacity * 8) {
+        close(fd);
+        return -1;
+    }
+    if (map(r, fd, (uint64_t) st.st_size, PROT_READ) < 0) {
+        return -1;
+    }
+    r->mask = h.capacity - 1;
+    r->pos  = atomic_load_explicit(&r->hdr->tail, memory_order_acquire);
+    r->end  = 0;
+    return 0;
+}
+
+void xyt_commit(xyt_ring *r)
+{
+    uint64_t end = r->pos + XYT_BATCH;
+
+    atomic_store_explicit(&r->hdr->head, r->pos, memory_order_release);
+    // Slots of the next batch go: readers must see tail move first
+    if (end > r->mask + 1) {
+        atomic_store_explicit(&r->hdr->tail, end - r->mask - 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+    r->end = end;
+}
+
+long xyt_read(xyt_ring *r, xyt_rec *buf, long n, uint64_t *lost)
+{
+    uint64_t head, tail, i;
+    uint32_t flags;
+
+    *lost = 0;
+    // Closed is read before head, so a closed ring with nothing left is done
+    flags = atomic_load_explicit(&r->hdr->flags, memory_order_acquire);
+    head  = atomic_load_explicit(&r->hdr->head, memory_order_acquire);
+    tail  = atomic_load_explicit(&r->hdr->tail, memory_order_acquire);
+    if (r->pos < tail) {
+        *lost = tail - r->pos;
+        r->pos = tail;
+    }
+    if (head - r->pos < (uint64_t) n) {
+        n = (long) (head - r->pos);
+    }
+    if (n == 0) {
+        return (flags & XYT_CLOSED) ? -1 : 0;
+    }
+    for (i = 0; i < (uint64_t) n; i++) {
+        buf[i] = r->rec[(r->pos + i) & r->mask];
+    }
+    // Whatever the writer started overwriting meanwhile is below tail now
+    atomic_thread_fence(memory_order_seq_cst);
+    tail = atomic_load_explicit(&r->hdr->tail, memory_order_relaxed);
+    if (tail > r->pos) {
+        i = tail - r->pos;
+        if (i >= (uint64_t) n) {
+            *lost += (uint64_t) n;
+            r->pos += (uint64_t) n;
+            return 0;
+        }
+        memmove(buf, buf + i, (size_t) (n - (long) i) * sizeof *buf);
+        *lost += i;
+        r->pos += i;
+        n -= (long) i;
+    }
+    r->pos += (uint64_t) n;
+    return n;
+}
+
+void xyt_close(xyt_ring *r, int writer)
+{
+    if (writer) {
+        atomic_store_explicit(&r->hdr->head, r->pos, memory_order_release);
+        atomic_fetch_or_explicit(&r->hdr->flags, XYT_CLOSED, memory_order_release);
+    }
+    munmap(r->hdr, r->size);
+    r->hdr = NULL;
+}
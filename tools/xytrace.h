@@ -0,0 +1,131 @@
+/*
+ * PIC Tennis DAC trace
+ *
+ * What the firmware writes to the two DACs, one record per write:
+ *
+ *   offset  size  field
+ *   0       4     tick   instruction cycle of the write (Fosc / 4), wraps
+ *   4       1     x      H DAC (LATC)
+ *   5       1     y      V DAC (LATB)
+ *   6       1     tag    what was being drawn, XYT_TAG_*
+ *   7       1     flags  0
+ *
+ * Little endian, 8 bytes. The beam stays at (x, y) until the tick of the
+ * next record. A flat trace is just records back to back.
+ *
+ * Ring file, for long runs: the writer maps it and stores records in place,
+ * readers map the same file and tail it while it is being written. Layout:
+ *
+ *   offset  size  field
+ *   0       4     magic     "XYTR"
+ *   4       2     version   XYT_VERSION
+ *   6       2     rec_size  8
+ *   8       4     capacity  records in the ring, power of 2
+ *   12      4     fcy       ticks per second
+ *   16      4     flags     XYT_CLOSED once the writer is done
+ *   20      44    0
+ *   64      8     head      records written so far, all of them are complete
+ *   72      8     tail      oldest record that is still intact
+ *   80      48    0
+ *   128           records, record n at slot n & (capacity - 1)
+ *
+ * There is one writer and any number of readers, no locks. The writer works
+ * in batches of XYT_BATCH records: it moves tail past the slots it is about
+ * to overwrite, writes the batch and then moves head. A reader keeps its own
+ * position, copies records up to head and then checks tail again: what is
+ * below tail by then may have been overwritten and is dropped.
+ */
+
+#ifndef XYTRACE_H
+#define XYTRACE_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#define XYT_TAG_NONE    0
+#define XYT_TAG_TRAIL   1
+#define XYT_TAG_BALL    2
+#define XYT_TAG_GROUND  3
+#define XYT_TAG_DEBUG   4
+
+#define XYT_MAGIC       "XYTR"
+#define XYT_VERSION     1
+#define XYT_HEADER      128
+#define XYT_BATCH       1024        // Records per head update
+#define XYT_CLOSED      0x01
+
+typedef struct {
+    uint32_t tick;
+    uint8_t  x;
+    uint8_t  y;
+    uint8_t  tag;
+    uint8_t  flags;
+} xyt_rec;
+
+typedef struct {
+    char     magic[4];
+    uint16_t version;
+    uint16_t rec_size;
+    uint32_t capacity;
+    uint32_t fcy;
+    _Atomic uint32_t flags;
+    uint8_t  pad0[44];
+    _Atomic uint64_t head;
+    _Atomic uint64_t tail;
+    uint8_t  pad1[48];
+} xyt_header;
+
+typedef struct {
+    xyt_header *hdr;
+    xyt_rec    *rec;
+    uint64_t   size;                // Mapped bytes
+    uint32_t   mask;
+    uint64_t   pos;                 // Writer: next record, reader: next to read
+    uint64_t   end;                 // Writer: end of the batch
+} xyt_ring;
+
+/**
+ * Create (or replace) a ring file of 2^bits records and map it for writing
+ */
+int  xyt_create(xyt_ring *r, const char *path, unsigned bits, uint32_t fcy);
+
+/**
+ * Map a ring file for reading, from the oldest intact record
+ */
+int  xyt_open(xyt_ring *r, const char *path);
+
+/**
+ * Writer: publish the batch so far and start the next one
+ */
+void xyt_commit(xyt_ring *r);
+
+/**
+ * Writer: one record. Inline, this is on the path of every DAC write
+ */
+static inline void xyt_put(xyt_ring *r, uint32_t tick, uint8_t x, uint8_t y, uint8_t tag)
+{
+    xyt_rec *p = &r->rec[r->pos & r->mask];
+
+    p->tick  = tick;
+    p->x     = x;
+    p->y     = y;
+    p->tag   = tag;
+    p->flags = 0;
+    if (++r->pos == r->end) {
+        xyt_commit(r);
+    }
+}
+
+/**
+ * Reader: copy up to n records. Returns the count, 0 when the writer has
+ * nothing new, -1 when it has closed the ring and everything was read.
+ * *lost gets the records that were overwritten before they could be read
+ */
+long xyt_read(xyt_ring *r, xyt_rec *buf, long n, uint64_t *lost);
+
+/**
+ * Writer: publish, mark closed. Both: unmap
+ */
+void xyt_close(xyt_ring *r, int writer);
+
+#endif